@@ -0,0 +1,110 @@
+/// \file
+///
+/// Benchmarks concurrent appends to concurrent_fixed_capacity_vector from 1
+/// to 8 threads (the `size` column).
+///
+/// Every call fills a vector of capacity 65536 with `int`s split evenly
+/// between the threads, and then freezes it; the time is reported per
+/// element. Elements are appended one at a time (`push_back`) or in batches
+/// of 64 (`grow_by`). The baseline is a fixed_capacity_vector protected by a
+/// `std::mutex`, locked per element or per batch.
+///
+/// The numbers include starting and joining the threads.
+#include <experimental/concurrent_fixed_capacity_vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils.hpp"
+
+constexpr std::size_t capacity = std::size_t{1} << 16;
+constexpr std::size_t batch    = 64;
+
+using concurrent_vector
+    = std::experimental::concurrent_fixed_capacity_vector<int, capacity>;
+
+/// fixed_capacity_vector protected by a mutex, with the interface of the
+/// concurrent vector.
+struct mutex_vector
+{
+    std::mutex m;
+    std::experimental::fixed_capacity_vector<
+        int, capacity, std::experimental::fcv_storage::uninitialized>
+        v;
+
+    int* try_push_back(int x)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return v.try_push_back(x);
+    }
+
+    int* grow_by(int const* first, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        v.append_range(first, first + n);
+        return v.end() - n;
+    }
+
+    std::size_t freeze()
+    {
+        return v.size();
+    }
+};
+
+/// Appends `capacity` elements to \p v from \p threads threads.
+template <typename V>
+void fill(V& v, std::size_t threads, bool batched)
+{
+    std::vector<std::thread> producers;
+    const std::size_t per = capacity / threads;
+    for (std::size_t t = 0; t != threads; ++t)
+    {
+        producers.emplace_back([&v, per, batched] {
+            if (batched)
+            {
+                int buffer[batch] = {};
+                for (std::size_t i = 0; i != per; i += batch)
+                {
+                    bench::do_not_optimize(v.grow_by(buffer, batch));
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i != per; ++i)
+                {
+                    bench::do_not_optimize(
+                        v.try_push_back(static_cast<int>(i)));
+                }
+            }
+        });
+    }
+    for (auto& p : producers)
+    {
+        p.join();
+    }
+    bench::do_not_optimize(v.freeze());
+}
+
+template <typename V>
+void bench_threads(bench::runner& r, char const* container)
+{
+    for (std::size_t threads : {1, 2, 4, 8})
+    {
+        for (bool batched : {false, true})
+        {
+            r.run("concurrent", batched ? "grow_by" : "push_back", container,
+                  "trivial", capacity, threads, capacity, [&] {
+                      auto v = std::make_unique<V>();
+                      fill(*v, threads, batched);
+                  });
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_threads<concurrent_vector>(r, "concurrent_fixed_capacity_vector");
+    bench_threads<mutex_vector>(r, "mutex_fixed_capacity_vector");
+    return 0;
+}
@@ -0,0 +1,208 @@
+/// \file
+///
+/// Benchmarks the word-level scans of fixed_capacity_bitvector and
+/// fixed_capacity_packed_vector against the same scans with the algorithms
+/// of `<algorithm>` on a fixed_capacity_vector of `bool`s or bytes, and
+/// against `std::bitset`.
+///
+/// The `flags` suite scans a full vector of `size` flags, of which about one
+/// in a hundred is set: `count` counts them, `find_first` finds a flag set
+/// only at the end, `any` scans flags that are all clear, and `fill` sets
+/// the middle half of the flags. The `nibbles` suite counts and finds a
+/// value in a full vector of `size` 4-bit integers. Both report the time per
+/// call. The `packets` suite counts the flags set in 65536 packets of 64
+/// flags each, and reports the time per packet.
+///
+/// The memory of each layout is printed on stderr.
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <experimental/fixed_capacity_bitvector>
+#include <experimental/fixed_capacity_vector>
+#include <vector>
+#include "utils.hpp"
+
+/// Is the \p i-th pseudo-random flag set? About one in a hundred is.
+bool flag(std::size_t i)
+{
+    return (i * 2654435761u >> 9) % 100 == 0;
+}
+
+template <std::size_t N>
+void bench_flags(bench::runner& r)
+{
+    using bitvector_t = std::experimental::fixed_capacity_bitvector<N>;
+    using vector_t    = std::experimental::fixed_capacity_vector<bool, N>;
+    std::fprintf(stderr,
+                 "# %zu flags: %zu bytes in fixed_capacity_vector<bool>, "
+                 "%zu in std::bitset, %zu in fixed_capacity_bitvector\n",
+                 N, sizeof(vector_t), sizeof(std::bitset<N>),
+                 sizeof(bitvector_t));
+
+    bitvector_t b(N);
+    vector_t v(N, false);
+    std::bitset<N> s;
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        b[i] = v[i] = flag(i);
+        s[i]        = flag(i);
+    }
+
+    r.run("flags", "count", "fixed_capacity_bitvector", "bool", N, N, 1, [&] {
+        bench::do_not_optimize(b);
+        bench::do_not_optimize(b.count());
+    });
+    r.run("flags", "count", "fixed_capacity_vector", "bool", N, N, 1, [&] {
+        bench::do_not_optimize(v);
+        bench::do_not_optimize(std::count(v.begin(), v.end(), true));
+    });
+    r.run("flags", "count", "std::bitset", "bool", N, N, 1, [&] {
+        bench::do_not_optimize(s);
+        bench::do_not_optimize(s.count());
+    });
+
+    // a single flag set, at the end:
+    bitvector_t last_b(N);
+    vector_t last_v(N, false);
+    last_b.back() = true;
+    last_v.back() = true;
+    r.run("flags", "find_first", "fixed_capacity_bitvector", "bool", N, N, 1,
+          [&] {
+              bench::do_not_optimize(last_b);
+              bench::do_not_optimize(last_b.find_first());
+          });
+    r.run("flags", "find_first", "fixed_capacity_vector", "bool", N, N, 1,
+          [&] {
+              bench::do_not_optimize(last_v);
+              bench::do_not_optimize(
+                  std::find(last_v.begin(), last_v.end(), true));
+          });
+
+    // all flags clear:
+    const bitvector_t none_b(N);
+    const vector_t none_v(N, false);
+    const std::bitset<N> none_s;
+    r.run("flags", "any", "fixed_capacity_bitvector", "bool", N, N, 1, [&] {
+        bench::do_not_optimize(none_b);
+        bench::do_not_optimize(none_b.any());
+    });
+    r.run("flags", "any", "fixed_capacity_vector", "bool", N, N, 1, [&] {
+        bench::do_not_optimize(none_v);
+        bench::do_not_optimize(std::any_of(none_v.begin(), none_v.end(),
+                                           [](bool x) { return x; }));
+    });
+    r.run("flags", "any", "std::bitset", "bool", N, N, 1, [&] {
+        bench::do_not_optimize(none_s);
+        bench::do_not_optimize(none_s.any());
+    });
+
+    r.run("flags", "fill", "fixed_capacity_bitvector", "bool", N, N, 1, [&] {
+        b.fill(N / 4, 3 * N / 4, true);
+        bench::clobber_memory();
+    });
+    r.run("flags", "fill", "fixed_capacity_vector", "bool", N, N, 1, [&] {
+        std::fill(v.begin() + N / 4, v.begin() + 3 * N / 4, true);
+        bench::clobber_memory();
+    });
+}
+
+template <std::size_t N>
+void bench_nibbles(bench::runner& r)
+{
+    using packed_t = std::experimental::fixed_capacity_packed_vector<4, N>;
+    using vector_t = std::experimental::fixed_capacity_vector<std::uint8_t, N>;
+    std::fprintf(stderr,
+                 "# %zu 4-bit integers: %zu bytes in "
+                 "fixed_capacity_vector<uint8_t>, %zu in "
+                 "fixed_capacity_packed_vector<4>\n",
+                 N, sizeof(vector_t), sizeof(packed_t));
+
+    packed_t p(N);
+    vector_t v(N, 0);
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        // 15 only at the end:
+        const auto x = static_cast<std::uint8_t>((i * 2654435761u >> 9) % 15);
+        p[i] = v[i] = x;
+    }
+    p.back() = v.back() = 15;
+
+    r.run("nibbles", "count", "fixed_capacity_packed_vector<4>", "uint8_t", N,
+          N, 1, [&] {
+              bench::do_not_optimize(p);
+              bench::do_not_optimize(p.count(7));
+          });
+    r.run("nibbles", "count", "fixed_capacity_vector", "uint8_t", N, N, 1,
+          [&] {
+              bench::do_not_optimize(v);
+              bench::do_not_optimize(
+                  std::count(v.begin(), v.end(), std::uint8_t{7}));
+          });
+    r.run("nibbles", "find", "fixed_capacity_packed_vector<4>", "uint8_t", N,
+          N, 1, [&] {
+              bench::do_not_optimize(p);
+              bench::do_not_optimize(p.find(15));
+          });
+    r.run("nibbles", "find", "fixed_capacity_vector", "uint8_t", N, N, 1,
+          [&] {
+              bench::do_not_optimize(v);
+              bench::do_not_optimize(
+                  std::find(v.begin(), v.end(), std::uint8_t{15}));
+          });
+}
+
+void bench_packets(bench::runner& r)
+{
+    constexpr std::size_t packets = std::size_t{1} << 16;
+    constexpr std::size_t flags   = 64;
+    using bitvector_t = std::experimental::fixed_capacity_bitvector<flags>;
+    using vector_t = std::experimental::fixed_capacity_vector<bool, flags>;
+    std::fprintf(stderr,
+                 "# %zu flags per packet: %zu bytes per packet in "
+                 "fixed_capacity_vector<bool>, %zu in "
+                 "fixed_capacity_bitvector\n",
+                 flags, sizeof(vector_t), sizeof(bitvector_t));
+
+    std::vector<bitvector_t> bs(packets, bitvector_t(flags));
+    std::vector<vector_t> vs(packets, vector_t(flags, false));
+    for (std::size_t p = 0; p != packets; ++p)
+    {
+        for (std::size_t i = 0; i != flags; ++i)
+        {
+            bs[p][i] = vs[p][i] = flag(p * flags + i);
+        }
+    }
+
+    r.run("packets", "count", "fixed_capacity_bitvector", "bool", flags,
+          packets, packets, [&] {
+              std::size_t n = 0;
+              for (auto const& b : bs)
+              {
+                  n += b.count();
+              }
+              bench::do_not_optimize(n);
+          });
+    r.run("packets", "count", "fixed_capacity_vector", "bool", flags,
+          packets, packets, [&] {
+              std::size_t n = 0;
+              for (auto const& v : vs)
+              {
+                  n += static_cast<std::size_t>(
+                      std::count(v.begin(), v.end(), true));
+              }
+              bench::do_not_optimize(n);
+          });
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_flags<64>(r);
+    bench_flags<512>(r);
+    bench_flags<4096>(r);
+    bench_nibbles<64>(r);
+    bench_nibbles<4096>(r);
+    bench_packets(r);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/// \file
+///
+/// Benchmarks lookups in fixed_capacity_flat_set and fixed_capacity_flat_map.
+///
+/// The `lookup` suite looks up 65536 pseudo-random keys, half of which are
+/// present, in a set of `size` `int` keys, and reports the time per lookup.
+/// There are enough keys that the branch predictor cannot learn them.
+/// The baselines are `std::lower_bound` over a sorted fixed_capacity_vector
+/// (the hand-written lookup tables this replaces), and `std::set`. The
+/// `chained` benchmark flips the lowest bit of every key depending on the
+/// previous lower bound, so it measures the latency of a search instead of
+/// the throughput.
+///
+/// The `map` suite does the same with `find` in a `fixed_capacity_flat_map`
+/// of `int` to `int`, against `std::map`.
+#include <algorithm>
+#include <experimental/fixed_capacity_flat_map>
+#include <experimental/fixed_capacity_vector>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+#include "utils.hpp"
+
+constexpr std::size_t lookups = std::size_t{1} << 16;
+
+/// Pseudo-random keys in [0, 2 * n): the even ones are in the containers.
+std::vector<int> make_keys(std::size_t n)
+{
+    std::vector<int> keys(lookups);
+    unsigned x = 12345;
+    for (auto& k : keys)
+    {
+        x = x * 1103515245u + 12345u;
+        k = static_cast<int>((x >> 8) % (2 * n));
+    }
+    return keys;
+}
+
+template <std::size_t N>
+void bench_lookup(bench::runner& r)
+{
+    const auto keys = make_keys(N);
+    {
+        auto s
+            = std::make_unique<std::experimental::fixed_capacity_flat_set<int,
+                                                                          N>>();
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            s->insert(static_cast<int>(2 * i));
+        }
+        r.run("lookup", "contains", "fixed_capacity_flat_set", "trivial", N, N,
+              lookups, [&] {
+                  std::size_t found = 0;
+                  for (int k : keys)
+                  {
+                      found += s->contains(k);
+                  }
+                  bench::do_not_optimize(found);
+              });
+        r.run("lookup", "chained", "fixed_capacity_flat_set", "trivial", N, N,
+              lookups, [&] {
+                  std::size_t i = 0;
+                  for (int k : keys)
+                  {
+                      const auto it = s->lower_bound(k ^ int(i & 1));
+                      i             = static_cast<std::size_t>(it - s->begin());
+                  }
+                  bench::do_not_optimize(i);
+              });
+    }
+    {
+        auto v = std::make_unique<
+            std::experimental::fixed_capacity_vector<int, N>>();
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            v->push_back(static_cast<int>(2 * i));
+        }
+        r.run("lookup", "contains", "std::lower_bound", "trivial", N, N,
+              lookups, [&] {
+                  std::size_t found = 0;
+                  for (int k : keys)
+                  {
+                      auto it = std::lower_bound(v->begin(), v->end(), k);
+                      found += it != v->end() && *it == k;
+                  }
+                  bench::do_not_optimize(found);
+              });
+        r.run("lookup", "chained", "std::lower_bound", "trivial", N, N,
+              lookups, [&] {
+                  std::size_t i = 0;
+                  for (int k : keys)
+                  {
+                      const auto it = std::lower_bound(v->begin(), v->end(),
+                                                       k ^ int(i & 1));
+                      i = static_cast<std::size_t>(it - v->begin());
+                  }
+                  bench::do_not_optimize(i);
+              });
+    }
+    {
+        std::set<int> s;
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            s.insert(static_cast<int>(2 * i));
+        }
+        r.run("lookup", "contains", "std::set", "trivial", N, N, lookups, [&] {
+            std::size_t found = 0;
+            for (int k : keys)
+            {
+                found += s.count(k);
+            }
+            bench::do_not_optimize(found);
+        });
+    }
+}
+
+template <std::size_t N>
+void bench_map(bench::runner& r)
+{
+    const auto keys = make_keys(N);
+    {
+        auto m = std::make_unique<
+            std::experimental::fixed_capacity_flat_map<int, int, N>>();
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            (*m)[static_cast<int>(2 * i)] = static_cast<int>(i);
+        }
+        r.run("map", "find", "fixed_capacity_flat_map", "trivial", N, N,
+              lookups, [&] {
+                  long sum = 0;
+                  for (int k : keys)
+                  {
+                      auto it = m->find(k);
+                      sum += it != m->end() ? it->second : 0;
+                  }
+                  bench::do_not_optimize(sum);
+              });
+    }
+    {
+        std::map<int, int> m;
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            m[static_cast<int>(2 * i)] = static_cast<int>(i);
+        }
+        r.run("map", "find", "std::map", "trivial", N, N, lookups, [&] {
+            long sum = 0;
+            for (int k : keys)
+            {
+                auto it = m.find(k);
+                sum += it != m.end() ? it->second : 0;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_lookup<8>(r);
+    bench_lookup<16>(r);
+    bench_lookup<32>(r);
+    bench_lookup<64>(r);
+    bench_lookup<128>(r);
+    bench_lookup<1024>(r);
+    bench_lookup<65536>(r);
+    bench_map<16>(r);
+    bench_map<1024>(r);
+    return 0;
+}
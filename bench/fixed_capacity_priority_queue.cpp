@@ -0,0 +1,173 @@
+/// \file
+///
+/// Benchmarks fixed_capacity_priority_queue, with 2-, 4- and 8-ary heaps,
+/// against `std::priority_queue` and against `std::push_heap` and
+/// `std::pop_heap` on a fixed_capacity_vector.
+///
+/// The `steady` suite pops the top of a queue of `size` `int`s and pushes a
+/// pseudo-random one, like a scheduler whose timers are rearmed, and reports
+/// the time per pop and push. The `top_k` suite selects the `size` largest
+/// of 65536 pseudo-random `int`s, and reports the time per streamed value.
+/// The `heapify` suite makes a queue of `size` pseudo-random `int`s, and
+/// reports the time per element.
+#include <algorithm>
+#include <experimental/fixed_capacity_priority_queue>
+#include <experimental/fixed_capacity_vector>
+#include <functional>
+#include <queue>
+#include <vector>
+#include "utils.hpp"
+
+constexpr std::size_t stream_size = std::size_t{1} << 16;
+
+/// Pseudo-random values.
+std::vector<int> make_values(std::size_t n)
+{
+    std::vector<int> values(n);
+    unsigned x = 12345;
+    for (auto& v : values)
+    {
+        x = x * 1103515245u + 12345u;
+        v = static_cast<int>(x >> 8);
+    }
+    return values;
+}
+
+/// Name of the queue with \p arity children per node.
+constexpr char const* queue_name(std::size_t arity)
+{
+    return arity == 2 ? "fixed_capacity_priority_queue<2>"
+                      : arity == 4 ? "fixed_capacity_priority_queue<4>"
+                                   : "fixed_capacity_priority_queue<8>";
+}
+
+template <std::size_t N, std::size_t Arity>
+void bench_steady_queue(bench::runner& r, std::vector<int> const& values)
+{
+    using queue_t = std::experimental::fixed_capacity_priority_queue<
+        int, N, std::less<int>, Arity>;
+    queue_t q(values.begin(), values.begin() + N);
+    std::size_t i = N;
+    r.run("steady", "pop+push", queue_name(Arity), "int", N, N,
+          stream_size, [&] {
+              for (std::size_t k = 0; k != stream_size; ++k)
+              {
+                  q.pop();
+                  q.push(values[i++ % values.size()]);
+              }
+              bench::do_not_optimize(q.top());
+          });
+}
+
+template <std::size_t N>
+void bench_steady(bench::runner& r)
+{
+    const auto values = make_values(stream_size);
+    bench_steady_queue<N, 2>(r, values);
+    bench_steady_queue<N, 4>(r, values);
+    bench_steady_queue<N, 8>(r, values);
+
+    std::experimental::fixed_capacity_vector<int, N> v(
+        values.begin(), values.begin() + N);
+    std::make_heap(v.begin(), v.end());
+    std::size_t i = N;
+    r.run("steady", "pop+push", "std::push_heap", "int", N, N, stream_size,
+          [&] {
+              for (std::size_t k = 0; k != stream_size; ++k)
+              {
+                  std::pop_heap(v.begin(), v.end());
+                  v.back() = values[i++ % values.size()];
+                  std::push_heap(v.begin(), v.end());
+              }
+              bench::do_not_optimize(v.front());
+          });
+
+    std::priority_queue<int> p(values.begin(), values.begin() + N);
+    std::size_t j = N;
+    r.run("steady", "pop+push", "std::priority_queue", "int", N, N,
+          stream_size, [&] {
+              for (std::size_t k = 0; k != stream_size; ++k)
+              {
+                  p.pop();
+                  p.push(values[j++ % values.size()]);
+              }
+              bench::do_not_optimize(p.top());
+          });
+}
+
+template <std::size_t N>
+void bench_top_k(bench::runner& r)
+{
+    const auto values = make_values(stream_size);
+    using queue_t = std::experimental::fixed_capacity_priority_queue<
+        int, N, std::greater<int>>;
+
+    r.run("top_k", "push_or_replace_min", queue_name(4), "int", N, N,
+          stream_size, [&] {
+              queue_t q;
+              for (int x : values)
+              {
+                  q.push_or_replace_min(x);
+              }
+              bench::do_not_optimize(q.top());
+          });
+    r.run("top_k", "pop+push", "std::priority_queue", "int", N, N,
+          stream_size, [&] {
+              std::vector<int> storage;
+              storage.reserve(N);
+              std::priority_queue<int, std::vector<int>, std::greater<int>> q(
+                  std::greater<int>(), std::move(storage));
+              for (int x : values)
+              {
+                  if (q.size() < N)
+                  {
+                      q.push(x);
+                  }
+                  else if (x > q.top())
+                  {
+                      q.pop();
+                      q.push(x);
+                  }
+              }
+              bench::do_not_optimize(q.top());
+          });
+}
+
+template <std::size_t N>
+void bench_heapify(bench::runner& r)
+{
+    const auto values = make_values(N);
+    using queue_t = std::experimental::fixed_capacity_priority_queue<int, N>;
+
+    r.run("heapify", "heapify", queue_name(4), "int", N, N, N, [&] {
+        queue_t q;
+        q.heapify(values.begin(), values.end());
+        bench::do_not_optimize(q.top());
+    });
+    r.run("heapify", "push", queue_name(4), "int", N, N, N, [&] {
+        queue_t q;
+        for (int x : values)
+        {
+            q.push(x);
+        }
+        bench::do_not_optimize(q.top());
+    });
+    r.run("heapify", "range constructor", "std::priority_queue", "int", N, N,
+          N, [&] {
+              std::priority_queue<int> q(values.begin(), values.end());
+              bench::do_not_optimize(q.top());
+          });
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_steady<16>(r);
+    bench_steady<256>(r);
+    bench_steady<4096>(r);
+    bench_top_k<16>(r);
+    bench_top_k<256>(r);
+    bench_heapify<64>(r);
+    bench_heapify<1024>(r);
+    return 0;
+}
@@ -0,0 +1,158 @@
+/// \file
+///
+/// Benchmarks fixed_capacity_ring and fixed_capacity_deque.
+///
+/// The `spsc` suite passes `items` integers from a producer thread to a
+/// consumer thread through a queue of capacity 1024, one at a time
+/// (`size` 1) or in batches (`size` 64), and reports the time per item. The
+/// baseline is a `std::deque` protected by a `std::mutex`. Both sides yield
+/// when the queue is full or empty, so that the benchmark also makes progress
+/// on a single core.
+///
+/// The `deque` suite pushes `size` elements at the front of an empty deque,
+/// and cycles `size` elements through a FIFO (push_back + pop_front),
+/// against `std::deque`.
+#include <algorithm>
+#include <deque>
+#include <experimental/fixed_capacity_ring>
+#include <mutex>
+#include <thread>
+#include "utils.hpp"
+
+constexpr std::size_t capacity = 1024;
+constexpr std::size_t items    = std::size_t{1} << 18;
+
+/// `std::deque` protected by a mutex, with the interface of the ring.
+struct mutex_queue
+{
+    std::mutex m;
+    std::deque<int> q;
+
+    std::size_t try_push_n(int const* first, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        const std::size_t room = capacity - q.size();
+        const std::size_t k    = n < room ? n : room;
+        q.insert(q.end(), first, first + k);
+        return k;
+    }
+
+    std::size_t try_pop_n(int* out, std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        const std::size_t k = n < q.size() ? n : q.size();
+        std::copy(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(k), out);
+        q.erase(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(k));
+        return k;
+    }
+};
+
+/// Transfers `items` integers from a new producer thread to this thread in
+/// batches of \p batch, and returns their sum.
+template <typename Q>
+long transfer(Q& q, std::size_t batch)
+{
+    std::thread producer([&] {
+        int buffer[64];
+        for (std::size_t i = 0; i != batch; ++i)
+        {
+            buffer[i] = 1;
+        }
+        std::size_t pushed = 0;
+        while (pushed != items)
+        {
+            const std::size_t n = items - pushed < batch ? items - pushed
+                                                         : batch;
+            std::size_t k;
+            if constexpr (std::is_same_v<Q, mutex_queue>)
+            {
+                k = q.try_push_n(buffer, n);
+            }
+            else
+            {
+                k = n == 1 ? std::size_t(q.try_push(buffer[0]))
+                           : q.try_push_n(buffer, n);
+            }
+            if (k == 0)
+            {
+                std::this_thread::yield();
+            }
+            pushed += k;
+        }
+    });
+    long sum           = 0;
+    std::size_t popped = 0;
+    int buffer[64];
+    while (popped != items)
+    {
+        const std::size_t k = q.try_pop_n(buffer, batch);
+        if (k == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i != k; ++i)
+        {
+            sum += buffer[i];
+        }
+        popped += k;
+    }
+    producer.join();
+    return sum;
+}
+
+void bench_spsc(bench::runner& r)
+{
+    for (std::size_t batch : {std::size_t{1}, std::size_t{64}})
+    {
+        r.run("spsc", "transfer", "fixed_capacity_ring", "trivial", capacity,
+              batch, items, [&] {
+                  std::experimental::fixed_capacity_ring<int, capacity> q;
+                  bench::do_not_optimize(transfer(q, batch));
+              });
+        r.run("spsc", "transfer", "mutex_deque", "trivial", capacity, batch,
+              items, [&] {
+                  mutex_queue q;
+                  bench::do_not_optimize(transfer(q, batch));
+              });
+    }
+}
+
+template <typename D>
+void bench_deque(bench::runner& r, char const* container, std::size_t n)
+{
+    r.run("deque", "push_front", container, "trivial", capacity, n, n, [&] {
+        D d;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            d.push_front(static_cast<int>(i));
+        }
+        bench::do_not_optimize(d);
+    });
+    {
+        D d;
+        r.run("deque", "fifo", container, "trivial", capacity, n, n, [&] {
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                d.push_back(static_cast<int>(i));
+            }
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                d.pop_front();
+            }
+            bench::do_not_optimize(d);
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_spsc(r);
+    for (std::size_t n : {std::size_t{16}, capacity})
+    {
+        bench_deque<std::experimental::fixed_capacity_deque<int, capacity>>(
+            r, "fixed_capacity_deque", n);
+        bench_deque<std::deque<int>>(r, "std::deque", n);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/// \file
+///
+/// Benchmarks single-field passes over particles stored as an array of
+/// structs (`fixed_capacity_vector<particle, N>`) and as a structure of
+/// arrays (`fixed_capacity_soa_vector<N, float, ..., int>`).
+///
+/// The `scan` benchmark sums the `x` field of every particle, and the
+/// `update` benchmark advances it by `vx * dt`; both report the time per
+/// particle. A particle is 32 bytes, so the array of structs loads 8 times
+/// (`scan`) or 4 times (`update`) as many bytes as the fields it uses.
+///
+/// Without `-ffast-math` the `scan` sum is not vectorized and is bound by the
+/// latency of the additions until the array of structs no longer fits in the
+/// caches.
+#include <experimental/fixed_capacity_soa_vector>
+#include <experimental/fixed_capacity_vector>
+#include <memory>
+#include "utils.hpp"
+
+struct particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    int id;
+};
+
+constexpr float dt = 0.01f;
+
+template <std::size_t N>
+using aos_vector = std::experimental::fixed_capacity_vector<particle, N>;
+
+template <std::size_t N>
+using soa_vector
+    = std::experimental::fixed_capacity_soa_vector<N, float, float, float,
+                                                   float, float, float, float,
+                                                   int>;
+
+template <std::size_t N>
+void fill(aos_vector<N>& v)
+{
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        const float f = static_cast<float>(i);
+        v.push_back(particle{f, f, f, 1.f, 1.f, 1.f, 1.f, int(i)});
+    }
+}
+
+template <std::size_t N>
+void fill(soa_vector<N>& v)
+{
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        const float f = static_cast<float>(i);
+        v.emplace_back(f, f, f, 1.f, 1.f, 1.f, 1.f, int(i));
+    }
+}
+
+template <std::size_t N>
+void bench_aos(bench::runner& r)
+{
+    auto v = std::make_unique<aos_vector<N>>();
+    fill(*v);
+    r.run("soa", "scan", "fixed_capacity_vector", "trivial", N, N, N, [&] {
+        float sum = 0;
+        for (auto const& p : *v)
+        {
+            sum += p.x;
+        }
+        bench::do_not_optimize(sum);
+    });
+    r.run("soa", "update", "fixed_capacity_vector", "trivial", N, N, N, [&] {
+        for (auto& p : *v)
+        {
+            p.x += p.vx * dt;
+        }
+        bench::clobber_memory();
+    });
+}
+
+template <std::size_t N>
+void bench_soa(bench::runner& r)
+{
+    auto v = std::make_unique<soa_vector<N>>();
+    fill(*v);
+    r.run("soa", "scan", "fixed_capacity_soa_vector", "trivial", N, N, N,
+          [&] {
+              float const* x = v->template data<0>();
+              float sum      = 0;
+              for (std::size_t i = 0; i != v->size(); ++i)
+              {
+                  sum += x[i];
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("soa", "update", "fixed_capacity_soa_vector", "trivial", N, N, N,
+          [&] {
+              float* x        = v->template data<0>();
+              float const* vx = v->template data<3>();
+              for (std::size_t i = 0; i != v->size(); ++i)
+              {
+                  x[i] += vx[i] * dt;
+              }
+              bench::clobber_memory();
+          });
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_aos<1024>(r);
+    bench_soa<1024>(r);
+    bench_aos<65536>(r);
+    bench_soa<65536>(r);
+    bench_aos<1048576>(r);
+    bench_soa<1048576>(r);
+    return 0;
+}
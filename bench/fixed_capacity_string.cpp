@@ -0,0 +1,147 @@
+/// \file
+///
+/// Benchmarks fixed_capacity_string against `std::string`, both for strings
+/// that fit in the small string buffer of `std::string` and for large ones.
+///
+/// The `search` suite calls `find` and `find_first_of` on a string of `size`
+/// characters whose match, if any, is near its end, and `compare` on two
+/// strings that differ in their last character; it reports the time per
+/// call. The `format` suite builds a log line of the form
+/// `"<prefix> id=<int> ms=<double>"` for `size` characters of prefix, the
+/// way a logger would: `std::string` through `operator+=` and
+/// `std::to_string`, and fixed_capacity_string through `append_to_chars`.
+#include <experimental/fixed_capacity_string>
+#include <string>
+#include <string_view>
+#include "utils.hpp"
+
+constexpr std::size_t calls = 1024;
+
+/// Characters of [a, z] followed by \p last, of \p n characters in total.
+std::string make_text(std::size_t n, char last)
+{
+    std::string s(n, ' ');
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        s[i] = static_cast<char>('a' + (i * 7) % 23);
+    }
+    s.back() = last;
+    return s;
+}
+
+template <std::size_t N>
+void bench_search(bench::runner& r)
+{
+    using string_t = std::experimental::fixed_capacity_string<N>;
+    const std::string text = make_text(N, 'z');
+    const std::string other = make_text(N, 'y');
+    const std::string_view needle = "az";
+    const std::string_view set = "{}|z";
+
+    string_t a(text), b(other);
+    std::string c = text, d = other;
+
+    r.run("search", "find", "fixed_capacity_string", "char", N, N, calls,
+          [&] {
+              std::size_t sum = 0;
+              for (std::size_t i = 0; i != calls; ++i)
+              {
+                  bench::do_not_optimize(a);
+                  sum += a.find(needle);
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("search", "find", "std::string", "char", N, N, calls, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i != calls; ++i)
+        {
+            bench::do_not_optimize(c);
+            sum += c.find(needle);
+        }
+        bench::do_not_optimize(sum);
+    });
+    r.run("search", "find_first_of", "fixed_capacity_string", "char", N, N,
+          calls, [&] {
+              std::size_t sum = 0;
+              for (std::size_t i = 0; i != calls; ++i)
+              {
+                  bench::do_not_optimize(a);
+                  sum += a.find_first_of(set);
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("search", "find_first_of", "std::string", "char", N, N, calls,
+          [&] {
+              std::size_t sum = 0;
+              for (std::size_t i = 0; i != calls; ++i)
+              {
+                  bench::do_not_optimize(c);
+                  sum += c.find_first_of(set);
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("search", "compare", "fixed_capacity_string", "char", N, N, calls,
+          [&] {
+              int sum = 0;
+              for (std::size_t i = 0; i != calls; ++i)
+              {
+                  bench::do_not_optimize(a);
+                  sum += a.compare(b);
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("search", "compare", "std::string", "char", N, N, calls, [&] {
+        int sum = 0;
+        for (std::size_t i = 0; i != calls; ++i)
+        {
+            bench::do_not_optimize(c);
+            sum += c.compare(d);
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+template <std::size_t N>
+void bench_format(bench::runner& r)
+{
+    // room for the prefix, " id=", an int, " ms=" and a double:
+    using string_t = std::experimental::fixed_capacity_string<N + 64>;
+    const std::string prefix = make_text(N, ':');
+
+    int id = 0;
+    r.run("format", "log line", "fixed_capacity_string", "char", N, N, calls,
+          [&] {
+              for (std::size_t i = 0; i != calls; ++i, ++id)
+              {
+                  string_t s(prefix);
+                  s += " id=";
+                  std::experimental::append_to_chars(s, id);
+                  s += " ms=";
+                  std::experimental::append_to_chars(s, id * 0.125);
+                  bench::do_not_optimize(s);
+              }
+          });
+    r.run("format", "log line", "std::string", "char", N, N, calls, [&] {
+        for (std::size_t i = 0; i != calls; ++i, ++id)
+        {
+            std::string s = prefix;
+            s += " id=";
+            s += std::to_string(id);
+            s += " ms=";
+            s += std::to_string(id * 0.125);
+            bench::do_not_optimize(s);
+        }
+    });
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_search<15>(r);
+    bench_search<64>(r);
+    bench_search<256>(r);
+    bench_search<1024>(r);
+    bench_format<8>(r);
+    bench_format<200>(r);
+    return 0;
+}
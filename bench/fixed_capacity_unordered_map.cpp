@@ -0,0 +1,160 @@
+/// \file
+///
+/// Benchmarks fixed_capacity_unordered_map against the containers it
+/// replaces for small bounded maps, e.g., stream id to state with at most 64
+/// entries: a linear scan over a fixed_capacity_vector of pairs, and
+/// `std::unordered_map`.
+///
+/// The `lookup` suite looks up 65536 pseudo-random `int` keys, half of which
+/// are present, in a full map of `size` `int` keys to `int` values, and
+/// reports the time per lookup. The `churn` suite replaces the elements of a
+/// full map one at a time, erasing the oldest key and inserting a new one,
+/// and reports the time per replacement; it also measures how the erased
+/// slots of the hash table are reclaimed.
+#include <algorithm>
+#include <experimental/fixed_capacity_unordered_map>
+#include <experimental/fixed_capacity_vector>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "utils.hpp"
+
+constexpr std::size_t lookups = std::size_t{1} << 16;
+
+/// Pseudo-random keys in [0, 2 * n): the even ones are in the containers.
+std::vector<int> make_keys(std::size_t n)
+{
+    std::vector<int> keys(lookups);
+    unsigned x = 12345;
+    for (auto& k : keys)
+    {
+        x = x * 1103515245u + 12345u;
+        k = static_cast<int>((x >> 8) % (2 * n));
+    }
+    return keys;
+}
+
+template <std::size_t N>
+void bench_lookup(bench::runner& r)
+{
+    using map_t    = std::experimental::fixed_capacity_unordered_map<int, int,
+                                                                  N>;
+    using vector_t = std::experimental::fixed_capacity_vector<
+        std::pair<int, int>, N>;
+    const auto keys = make_keys(N);
+
+    auto m = std::make_unique<map_t>();
+    vector_t v;
+    std::unordered_map<int, int> u;
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        const int k = static_cast<int>(2 * i);
+        m->try_emplace(k, k);
+        v.emplace_back(k, k);
+        u.emplace(k, k);
+    }
+
+    r.run("lookup", "find", "fixed_capacity_unordered_map", "int", N, N,
+          lookups, [&] {
+              long sum = 0;
+              for (int k : keys)
+              {
+                  auto it = m->find(k);
+                  sum += it != m->end() ? it->second : 0;
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("lookup", "find_if", "fixed_capacity_vector<pair>", "int", N, N,
+          lookups, [&] {
+              long sum = 0;
+              for (int k : keys)
+              {
+                  auto it = std::find_if(v.begin(), v.end(), [&](auto& x) {
+                      return x.first == k;
+                  });
+                  sum += it != v.end() ? it->second : 0;
+              }
+              bench::do_not_optimize(sum);
+          });
+    r.run("lookup", "find", "std::unordered_map", "int", N, N, lookups, [&] {
+        long sum = 0;
+        for (int k : keys)
+        {
+            auto it = u.find(k);
+            sum += it != u.end() ? it->second : 0;
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+template <std::size_t N>
+void bench_churn(bench::runner& r)
+{
+    using map_t    = std::experimental::fixed_capacity_unordered_map<int, int,
+                                                                  N>;
+    using vector_t = std::experimental::fixed_capacity_vector<
+        std::pair<int, int>, N>;
+    constexpr std::size_t n = 1024;
+
+    // Every replacement erases key k - N and inserts key k:
+    auto m = std::make_unique<map_t>();
+    vector_t v;
+    std::unordered_map<int, int> u;
+    int km = 0, kv = 0, ku = 0;
+    for (; km != static_cast<int>(N); ++km, ++kv, ++ku)
+    {
+        m->try_emplace(km, km);
+        v.emplace_back(kv, kv);
+        u.emplace(ku, ku);
+    }
+
+    r.run("churn", "erase+insert", "fixed_capacity_unordered_map", "int", N,
+          N, n, [&] {
+              for (std::size_t i = 0; i != n; ++i, ++km)
+              {
+                  m->erase(km - static_cast<int>(N));
+                  m->try_emplace(km, km);
+              }
+              bench::clobber_memory();
+          });
+    r.run("churn", "erase+insert", "fixed_capacity_vector<pair>", "int", N,
+          N, n, [&] {
+              for (std::size_t i = 0; i != n; ++i, ++kv)
+              {
+                  const int old = kv - static_cast<int>(N);
+                  auto it = std::find_if(v.begin(), v.end(), [&](auto& x) {
+                      return x.first == old;
+                  });
+                  // unordered erase: the order is irrelevant
+                  *it = v.back();
+                  v.pop_back();
+                  if (std::none_of(v.begin(), v.end(),
+                                   [&](auto& x) { return x.first == kv; }))
+                  {
+                      v.emplace_back(kv, kv);
+                  }
+              }
+              bench::clobber_memory();
+          });
+    r.run("churn", "erase+insert", "std::unordered_map", "int", N, N, n, [&] {
+        for (std::size_t i = 0; i != n; ++i, ++ku)
+        {
+            u.erase(ku - static_cast<int>(N));
+            u.try_emplace(ku, ku);
+        }
+        bench::clobber_memory();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_lookup<8>(r);
+    bench_lookup<16>(r);
+    bench_lookup<32>(r);
+    bench_lookup<64>(r);
+    bench_churn<8>(r);
+    bench_churn<64>(r);
+    return 0;
+}
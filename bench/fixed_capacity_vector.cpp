@@ -0,0 +1,655 @@
+/// \file
+///
+/// Benchmarks fixed_capacity_vector against std::vector.
+///
+/// Every benchmark is run for the `trivial` and `non_trivial` storage
+/// policies at capacities 8, 64, 1024, and 65536, and for `zero_sized` storage
+/// where the operation is meaningful. Trivial elements are also run with the
+/// `fcv_storage::uninitialized` policy (`trivial_uninitialized`).
+///
+/// The `fill_ratio` suite measures copies and moves of a capacity 4096 vector
+/// of `std::uint32_t` holding from 0% to 100% of its capacity. The std::vector
+/// baseline reserves the same capacity up-front so that no reallocation is
+/// measured.
+///
+/// The `compare` suite measures `==` and `<` on full vectors of 16 to 4096
+/// elements (the `storage` column names the element type) that only differ in
+/// their last element.
+///
+/// The `aligned` suite measures `y = a * x + y` over `float` vectors holding
+/// 3 elements less than a multiple of 8. The default storage runs a loop over
+/// `size()`, whose vectorized form needs a scalar tail. The
+/// `fcv_storage::aligned<32>` storage (`aligned32`) runs over `size()`
+/// rounded up to a whole block of 8 elements with 32-byte aligned pointers.
+/// The difference only shows on targets with 32-byte vectors (e.g.
+/// `-mavx2`); with the default SSE2 both loops take the same time.
+///
+/// The `relocate` suite measures moves, swaps, and insertions and erasures
+/// at the front of a capacity 256 vector of `std::unique_ptr<int>`, which is
+/// trivially relocatable, against the same operations on a wrapper of
+/// `std::unique_ptr<int>` that is not (`boxed`), whose elements are moved
+/// one by one. `move_construct` move-constructs a vector and move-assigns it
+/// back; `insert_erase` inserts and erases the first of 255 elements.
+///
+/// The `erase` suite removes 1%, 10%, 50% and 90% (the `storage` column) of
+/// the elements of a vector of 4096 `std::uint32_t`, chosen pseudo-randomly:
+/// one at a time with `erase` (`erase_loop`) or `unordered_erase`
+/// (`unordered_erase_loop`), or in one pass with `erase_if`, against
+/// `std::remove_if` on a `std::vector`. Times are per element, and include
+/// restoring the vector with a copy (`refill`). `erase_if` packs blocks of
+/// elements with one permutation on targets with AVX2 (e.g. `-mavx2`).
+///
+/// The `assign` suite reassigns a vector of 32 `std::string`s of 40
+/// characters (too long for the small-string buffer) from another one, with
+/// `operator=` (`copy_assign`) and `assign(first, last)` (`assign_range`),
+/// alternating between two sources of 32 and 24 strings. Times are per
+/// element.
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <experimental/fixed_capacity_vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include "utils.hpp"
+
+template <typename T, std::size_t N>
+using vector = std::experimental::fixed_capacity_vector<T, N>;
+
+template <typename T, std::size_t N>
+using uninitialized_vector = std::experimental::fixed_capacity_vector<
+    T, N, std::experimental::fcv_storage::uninitialized>;
+
+template <typename T, std::size_t N>
+using aligned_vector = std::experimental::fixed_capacity_vector<
+    T, N, std::experimental::fcv_storage::aligned<32>>;
+
+template <typename V>
+struct container_traits;
+
+template <typename T, std::size_t N, typename S>
+struct container_traits<std::experimental::fixed_capacity_vector<T, N, S>>
+{
+    static constexpr char const* name = "fixed_capacity_vector";
+};
+
+template <typename T>
+struct container_traits<std::vector<T>>
+{
+    static constexpr char const* name = "std::vector";
+};
+
+/// Heap-allocated container with capacity for \p capacity elements holding
+/// `[0, size)`.
+template <typename V>
+std::unique_ptr<V> make(std::size_t capacity, std::size_t size)
+{
+    auto v = std::make_unique<V>();
+    if constexpr (std::is_same_v<V, std::vector<typename V::value_type>>)
+    {
+        v->reserve(capacity);
+    }
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v->push_back(typename V::value_type(static_cast<int>(i)));
+    }
+    return v;
+}
+
+template <typename V>
+void bench_all(bench::runner& r, char const* storage, std::size_t capacity)
+{
+    using T           = typename V::value_type;
+    char const* suite = "fixed_capacity_vector";
+    char const* c     = container_traits<V>::name;
+    std::size_t n     = capacity;
+
+    {  // default construct (std::vector: construct + reserve)
+        bench::buffer<V> buf;
+        r.run(suite, "default_construct", c, storage, capacity, 0, 1, [&] {
+            V* p = new (buf.get()) V;
+            if constexpr (std::is_same_v<V, std::vector<T>>)
+            {
+                p->reserve(capacity);
+            }
+            bench::do_not_optimize(*p);
+            p->~V();
+        });
+    }
+    {  // push_back n elements into an empty vector
+        auto v = make<V>(capacity, 0);
+        r.run(suite, "push_back", c, storage, capacity, n, n, [&] {
+            v->clear();
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                v->push_back(T(static_cast<int>(i)));
+            }
+            bench::do_not_optimize(*v);
+        });
+    }
+    {  // emplace_back n elements into an empty vector
+        auto v = make<V>(capacity, 0);
+        r.run(suite, "emplace_back", c, storage, capacity, n, n, [&] {
+            v->clear();
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                v->emplace_back(static_cast<int>(i));
+            }
+            bench::do_not_optimize(*v);
+        });
+    }
+    if constexpr (!std::is_same_v<V, std::vector<T>>)
+    {
+        auto v = make<V>(capacity, 0);
+        r.run(suite, "unchecked_emplace_back", c, storage, capacity, n, n,
+              [&] {
+                  v->clear();
+                  for (std::size_t i = 0; i != n; ++i)
+                  {
+                      v->unchecked_emplace_back(static_cast<int>(i));
+                  }
+                  bench::do_not_optimize(*v);
+              });
+        r.run(suite, "try_push_back", c, storage, capacity, n, n, [&] {
+            v->clear();
+            for (int i = 0; v->try_push_back(T(i)); ++i)
+            {
+            }
+            bench::do_not_optimize(*v);
+        });
+    }
+    {  // append n elements from a contiguous range to an empty vector
+        auto v   = make<V>(capacity, 0);
+        auto src = make<std::vector<T>>(n, n);
+        r.run(suite, "append_range", c, storage, capacity, n, n, [&] {
+            v->clear();
+            if constexpr (std::is_same_v<V, std::vector<T>>)
+            {
+                v->insert(v->end(), src->data(), src->data() + n);
+            }
+            else
+            {
+                v->append_range(src->data(), src->data() + n);
+            }
+            bench::do_not_optimize(*v);
+        });
+    }
+
+    // insert/erase: keep the size constant at capacity - 1 by pairing every
+    // insert with a pop_back and every erase with a push_back.
+    auto bench_insert = [&](char const* name, std::size_t offset) {
+        auto v = make<V>(capacity, n - 1);
+        T x(42);
+        r.run(suite, name, c, storage, capacity, n - 1, 1, [&] {
+            v->insert(v->begin() + static_cast<std::ptrdiff_t>(offset), x);
+            v->pop_back();
+            bench::do_not_optimize(*v);
+        });
+    };
+    bench_insert("insert_front", 0);
+    bench_insert("insert_middle", (n - 1) / 2);
+    bench_insert("insert_back", n - 1);
+
+    {  // insert a range of n / 4 elements in the middle
+        std::size_t m = n / 4;
+        auto v        = make<V>(capacity, n - m);
+        auto src      = make<std::vector<T>>(m, m);
+        r.run(suite, "insert_range_middle", c, storage, capacity, n - m, 1,
+              [&] {
+                  auto pos = v->begin()
+                             + static_cast<std::ptrdiff_t>((n - m) / 2);
+                  v->insert(pos, src->data(), src->data() + m);
+                  v->erase(v->end() - static_cast<std::ptrdiff_t>(m),
+                           v->end());
+                  bench::do_not_optimize(*v);
+              });
+    }
+
+    auto bench_erase = [&](char const* name, std::size_t offset) {
+        auto v = make<V>(capacity, n);
+        T x(42);
+        r.run(suite, name, c, storage, capacity, n, 1, [&] {
+            v->erase(v->begin() + static_cast<std::ptrdiff_t>(offset));
+            v->push_back(x);
+            bench::do_not_optimize(*v);
+        });
+    };
+    bench_erase("erase_front", 0);
+    bench_erase("erase_middle", n / 2);
+    bench_erase("erase_back", n - 1);
+
+    {  // copy construct a full vector
+        auto a = make<V>(capacity, n);
+        bench::buffer<V> buf;
+        r.run(suite, "copy_construct", c, storage, capacity, n, 1, [&] {
+            V* p = new (buf.get()) V(*a);
+            bench::do_not_optimize(*p);
+            p->~V();
+        });
+    }
+    {  // move construct a full vector, then move it back into the source
+        auto a = make<V>(capacity, n);
+        bench::buffer<V> buf;
+        r.run(suite, "move_construct", c, storage, capacity, n, 1, [&] {
+            V* p = new (buf.get()) V(std::move(*a));
+            bench::do_not_optimize(*p);
+            *a = std::move(*p);
+            p->~V();
+        });
+    }
+    {  // copy assign a full vector over a full vector
+        auto a = make<V>(capacity, n);
+        auto b = make<V>(capacity, n);
+        r.run(suite, "copy_assign", c, storage, capacity, n, 1, [&] {
+            *b = *a;
+            bench::do_not_optimize(*b);
+        });
+    }
+    {  // move assign back and forth between two vectors
+        auto a = make<V>(capacity, n);
+        auto b = make<V>(capacity, n);
+        r.run(suite, "move_assign", c, storage, capacity, n, 2, [&] {
+            *b = std::move(*a);
+            bench::do_not_optimize(*b);
+            *a = std::move(*b);
+            bench::do_not_optimize(*a);
+        });
+    }
+    {  // swap a full and a half-full vector
+        auto a = make<V>(capacity, n);
+        auto b = make<V>(capacity, n / 2);
+        r.run(suite, "swap", c, storage, capacity, n, 1, [&] {
+            a->swap(*b);
+            bench::do_not_optimize(*a);
+            bench::do_not_optimize(*b);
+        });
+    }
+    {  // resize from zero to capacity and back
+        auto v = make<V>(capacity, 0);
+        r.run(suite, "resize", c, storage, capacity, n, 1, [&] {
+            v->resize(n);
+            bench::do_not_optimize(*v);
+            v->resize(0);
+            bench::do_not_optimize(*v);
+        });
+    }
+    if constexpr (!std::is_same_v<V, std::vector<T>>)
+    {  // resize without value-initializing the new elements
+        auto v = make<V>(capacity, 0);
+        r.run(suite, "resize_default_init", c, storage, capacity, n, 1, [&] {
+            v->resize(n, std::experimental::default_init);
+            bench::do_not_optimize(*v);
+            v->resize(0);
+            bench::do_not_optimize(*v);
+        });
+        if constexpr (std::is_trivial_v<T>)
+        {  // fill from a "read" of n elements
+            auto src = make<std::vector<T>>(n, n);
+            r.run(suite, "resize_and_overwrite", c, storage, capacity, n, 1,
+                  [&] {
+                      v->resize_and_overwrite(n, [&](T* p, std::size_t m) {
+                          std::memcpy(p, src->data(), m * sizeof(T));
+                          return m;
+                      });
+                      bench::do_not_optimize(*v);
+                      v->resize(0);
+                  });
+            r.run(suite, "resize_then_overwrite", c, storage, capacity, n, 1,
+                  [&] {
+                      v->resize(n);
+                      std::memcpy(v->data(), src->data(), n * sizeof(T));
+                      bench::do_not_optimize(*v);
+                      v->resize(0);
+                  });
+        }
+    }
+    {  // comparisons between two equal full vectors (worst case)
+        auto a = make<V>(capacity, n);
+        auto b = make<V>(capacity, n);
+        r.run(suite, "equal", c, storage, capacity, n, 1, [&] {
+            bool x = *a == *b;
+            bench::do_not_optimize(x);
+        });
+        r.run(suite, "less", c, storage, capacity, n, 1, [&] {
+            bool x = *a < *b;
+            bench::do_not_optimize(x);
+        });
+    }
+}
+
+/// zero_sized storage: only the operations that are valid on an empty
+/// vector.
+template <typename V>
+void bench_zero_sized(bench::runner& r)
+{
+    char const* suite   = "fixed_capacity_vector";
+    char const* c       = container_traits<V>::name;
+    char const* storage = "zero_sized";
+    {
+        bench::buffer<V> buf;
+        r.run(suite, "default_construct", c, storage, 0, 0, 1, [&] {
+            V* p = new (buf.get()) V;
+            bench::do_not_optimize(*p);
+            p->~V();
+        });
+    }
+    {
+        V a;
+        bench::buffer<V> buf;
+        r.run(suite, "copy_construct", c, storage, 0, 0, 1, [&] {
+            V* p = new (buf.get()) V(a);
+            bench::do_not_optimize(*p);
+            p->~V();
+        });
+    }
+    {
+        V a, b;
+        r.run(suite, "copy_assign", c, storage, 0, 0, 1, [&] {
+            b = a;
+            bench::do_not_optimize(b);
+        });
+        r.run(suite, "swap", c, storage, 0, 0, 1, [&] {
+            a.swap(b);
+            bench::do_not_optimize(a);
+            bench::do_not_optimize(b);
+        });
+        r.run(suite, "equal", c, storage, 0, 0, 1, [&] {
+            bool x = a == b;
+            bench::do_not_optimize(x);
+        });
+    }
+}
+
+/// Copies and moves of a vector holding \p size elements.
+template <typename V>
+void bench_fill_ratio(bench::runner& r, char const* storage,
+                      std::size_t capacity, std::size_t size)
+{
+    char const* suite = "fill_ratio";
+    char const* c     = container_traits<V>::name;
+    {
+        auto a = make<V>(capacity, size);
+        bench::buffer<V> buf;
+        r.run(suite, "copy_construct", c, storage, capacity, size, 1, [&] {
+            V* p = new (buf.get()) V(*a);
+            bench::do_not_optimize(*p);
+            p->~V();
+        });
+        r.run(suite, "move_construct", c, storage, capacity, size, 1, [&] {
+            V* p = new (buf.get()) V(std::move(*a));
+            bench::do_not_optimize(*p);
+            p->~V();
+        });
+    }
+    {
+        auto a = make<V>(capacity, size);
+        auto b = make<V>(capacity, size);
+        r.run(suite, "copy_assign", c, storage, capacity, size, 1, [&] {
+            *b = *a;
+            bench::do_not_optimize(*b);
+        });
+    }
+}
+
+template <std::size_t Capacity>
+void bench_fill_ratios(bench::runner& r)
+{
+    using T = std::uint32_t;
+    for (std::size_t size :
+         {std::size_t{0}, Capacity / 64, Capacity / 4, Capacity / 2, Capacity})
+    {
+        bench_fill_ratio<vector<T, Capacity>>(r, "trivial", Capacity, size);
+        bench_fill_ratio<uninitialized_vector<T, Capacity>>(
+            r, "trivial_uninitialized", Capacity, size);
+        bench_fill_ratio<std::experimental::fixed_capacity_vector<
+            T, Capacity,
+            std::experimental::fcv_storage::uninitialized_trivially_copyable>>(
+            r, "trivial_uninitialized_trivially_copyable", Capacity, size);
+    }
+}
+
+/// Equality and ordering of two keys of \p size elements that only differ
+/// in their last element, which is the worst case.
+template <typename V>
+void bench_compare(bench::runner& r, char const* element, std::size_t size)
+{
+    using T           = typename V::value_type;
+    char const* suite = "compare";
+    char const* c     = container_traits<V>::name;
+    auto a            = make<V>(size, 0);
+    auto b            = make<V>(size, 0);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        a->push_back(T(static_cast<int>(i % 100)));
+        b->push_back(T(static_cast<int>(i + 1 == size ? 100 : i % 100)));
+    }
+    r.run(suite, "equal", c, element, size, size, 1, [&] {
+        bench::do_not_optimize(*a == *b);
+    });
+    r.run(suite, "less", c, element, size, size, 1, [&] {
+        bench::do_not_optimize(*a < *b);
+    });
+}
+
+template <std::size_t Capacity>
+void bench_compares(bench::runner& r)
+{
+    bench_compare<vector<std::uint8_t, Capacity>>(r, "uint8", Capacity);
+    bench_compare<std::vector<std::uint8_t>>(r, "uint8", Capacity);
+    bench_compare<vector<std::uint32_t, Capacity>>(r, "uint32", Capacity);
+    bench_compare<std::vector<std::uint32_t>>(r, "uint32", Capacity);
+    bench_compare<vector<bench::non_trivial_t, Capacity>>(r, "non_trivial",
+                                                          Capacity);
+    bench_compare<std::vector<bench::non_trivial_t>>(r, "non_trivial",
+                                                     Capacity);
+}
+
+/// `y = a * x + y` over \p size elements.
+template <std::size_t Size>
+void bench_aligned(bench::runner& r)
+{
+    char const* suite       = "aligned";
+    char const* c           = "fixed_capacity_vector";
+    constexpr float a       = 1.5f;
+    constexpr std::size_t n = (Size + 7) / 8 * 8;
+    {
+        auto x = std::make_unique<vector<float, n>>(Size, 1.f);
+        auto y = std::make_unique<vector<float, n>>(Size, 2.f);
+        r.run(suite, "saxpy", c, "trivial", n, Size, Size, [&] {
+            float const* xs = x->data();
+            float* ys       = y->data();
+            for (std::size_t i = 0; i != y->size(); ++i)
+            {
+                ys[i] = a * xs[i] + ys[i];
+            }
+            bench::clobber_memory();
+        });
+    }
+    {
+        auto x = std::make_unique<aligned_vector<float, Size>>(Size, 1.f);
+        auto y = std::make_unique<aligned_vector<float, Size>>(Size, 2.f);
+        r.run(suite, "saxpy", c, "aligned32", n, Size, Size, [&] {
+            auto xs = static_cast<float const*>(
+                __builtin_assume_aligned(x->data(), 32));
+            auto ys = static_cast<float*>(
+                __builtin_assume_aligned(y->data(), 32));
+            // Whole blocks of 8: the padding past size() is alive.
+            const std::size_t e = (y->size() + 7) & ~std::size_t{7};
+            for (std::size_t i = 0; i != e; ++i)
+            {
+                ys[i] = a * xs[i] + ys[i];
+            }
+            bench::clobber_memory();
+        });
+    }
+}
+
+/// A `std::unique_ptr<int>` that is not trivially relocatable.
+struct boxed
+{
+    std::unique_ptr<int> p;
+};
+
+template <typename T>
+void bench_relocate(bench::runner& r, char const* storage,
+                    T (*make)(int))
+{
+    constexpr std::size_t n = 256;
+    using V                 = vector<T, n>;
+    char const* suite       = "relocate";
+    char const* c           = "fixed_capacity_vector";
+    auto a                  = std::make_unique<V>();
+    auto b                  = std::make_unique<V>();
+    auto refill             = [&](V& v, std::size_t size) {
+        v.clear();
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            v.push_back(make(static_cast<int>(i)));
+        }
+    };
+
+    refill(*a, n);
+    r.run(suite, "move_assign", c, storage, n, n, 2, [&] {
+        *b = std::move(*a);
+        *a = std::move(*b);
+        bench::do_not_optimize(a->data());
+    });
+    r.run(suite, "move_construct", c, storage, n, n, 1, [&] {
+        alignas(V) unsigned char buffer[sizeof(V)];
+        V* t = ::new (buffer) V(std::move(*a));
+        *a   = std::move(*t);
+        t->~V();
+        bench::do_not_optimize(a->data());
+    });
+    refill(*b, n / 2);
+    r.run(suite, "swap", c, storage, n, n, 1, [&] {
+        a->swap(*b);
+        bench::do_not_optimize(a->data());
+    });
+    refill(*a, n - 1);
+    T x = make(-1);
+    r.run(suite, "insert_erase", c, storage, n, n - 1, 1, [&] {
+        a->insert(a->begin(), std::move(x));
+        x = std::move(a->front());
+        a->erase(a->begin());
+        bench::do_not_optimize(a->data());
+    });
+}
+
+template <unsigned Percent>
+void bench_erase(bench::runner& r, char const* density)
+{
+    constexpr std::size_t n = 4096;
+    using V                 = vector<std::uint32_t, n>;
+    char const* suite       = "erase";
+    char const* c           = "fixed_capacity_vector";
+    auto src                = std::make_unique<V>();
+    for (std::uint32_t i = 0; i != n; ++i)
+    {
+        src->push_back((i * 2654435761u >> 9) % 100);
+    }
+    auto pred = [](std::uint32_t x) { return x < Percent; };
+    auto v    = std::make_unique<V>();
+
+    r.run(suite, "refill", c, density, n, n, n, [&] {
+        *v = *src;
+        bench::do_not_optimize(v->data());
+    });
+    r.run(suite, "erase_loop", c, density, n, n, n, [&] {
+        *v = *src;
+        for (auto it = v->begin(); it != v->end();)
+        {
+            it = pred(*it) ? v->erase(it) : it + 1;
+        }
+        bench::do_not_optimize(v->data());
+    });
+    r.run(suite, "unordered_erase_loop", c, density, n, n, n, [&] {
+        *v = *src;
+        for (auto it = v->begin(); it != v->end();)
+        {
+            it = pred(*it) ? v->unordered_erase(it) : it + 1;
+        }
+        bench::do_not_optimize(v->data());
+    });
+    r.run(suite, "erase_if", c, density, n, n, n, [&] {
+        *v = *src;
+        std::experimental::erase_if(*v, pred);
+        bench::do_not_optimize(v->data());
+    });
+
+    std::vector<std::uint32_t> s(src->begin(), src->end());
+    std::vector<std::uint32_t> w;
+    w.reserve(n);
+    r.run(suite, "remove_if", "std::vector", density, n, n, n, [&] {
+        w.assign(s.begin(), s.end());
+        w.erase(std::remove_if(w.begin(), w.end(), pred), w.end());
+        bench::do_not_optimize(w.data());
+    });
+}
+
+template <typename V>
+void bench_assign(bench::runner& r, char const* container)
+{
+    constexpr std::size_t n = 32;
+    char const* suite       = "assign";
+    V x, y, v;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        x.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+        if (i < 3 * n / 4)
+        {
+            y.push_back(std::string(40, static_cast<char>('z' - i % 26)));
+        }
+    }
+    r.run(suite, "copy_assign", container, "string", n, n, 2 * n, [&] {
+        v = x;
+        v = y;
+        bench::do_not_optimize(v.data());
+    });
+    r.run(suite, "assign_range", container, "string", n, n, 2 * n, [&] {
+        v.assign(x.begin(), x.end());
+        v.assign(y.begin(), y.end());
+        bench::do_not_optimize(v.data());
+    });
+}
+
+template <std::size_t Capacity>
+void bench_capacity(bench::runner& r)
+{
+    bench_all<vector<bench::trivial_t, Capacity>>(r, "trivial", Capacity);
+    bench_all<uninitialized_vector<bench::trivial_t, Capacity>>(
+        r, "trivial_uninitialized", Capacity);
+    bench_all<std::vector<bench::trivial_t>>(r, "trivial", Capacity);
+    bench_all<vector<bench::non_trivial_t, Capacity>>(r, "non_trivial",
+                                                      Capacity);
+    bench_all<std::vector<bench::non_trivial_t>>(r, "non_trivial", Capacity);
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_zero_sized<vector<bench::trivial_t, 0>>(r);
+    bench_zero_sized<std::vector<bench::trivial_t>>(r);
+    bench_capacity<8>(r);
+    bench_capacity<64>(r);
+    bench_capacity<1024>(r);
+    bench_capacity<65536>(r);
+    bench_fill_ratios<4096>(r);
+    bench_compares<16>(r);
+    bench_compares<256>(r);
+    bench_compares<4096>(r);
+    bench_aligned<13>(r);
+    bench_aligned<61>(r);
+    bench_aligned<1021>(r);
+    bench_relocate<std::unique_ptr<int>>(
+        r, "unique_ptr", [](int i) { return std::make_unique<int>(i); });
+    bench_relocate<boxed>(
+        r, "boxed", [](int i) { return boxed{std::make_unique<int>(i)}; });
+    bench_erase<1>(r, "1%");
+    bench_erase<10>(r, "10%");
+    bench_erase<50>(r, "50%");
+    bench_erase<90>(r, "90%");
+    bench_assign<vector<std::string, 32>>(r, "fixed_capacity_vector");
+    bench_assign<std::vector<std::string>>(r, "std::vector");
+    return 0;
+}
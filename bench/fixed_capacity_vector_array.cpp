@@ -0,0 +1,124 @@
+/// \file
+///
+/// Benchmarks scans over many small vectors stored as an array of
+/// `fixed_capacity_vector<T, 8>` and as a `fixed_capacity_vector_array<T, 8,
+/// N>`, e.g., the adjacency lists of a graph with N vertices.
+///
+/// The vectors hold 0 to 8 elements (4 on average). The `scan` benchmark sums
+/// every element of every vector, through the vector references
+/// (`fixed_capacity_vector_array`) or through `data()` and `sizes()`
+/// (`fixed_capacity_vector_array/raw`). The `degree` benchmark sums the sizes
+/// of the vectors only. Both report the time per vector.
+///
+/// The memory per vector of each layout is printed on stderr: an array of
+/// `fixed_capacity_vector<std::uint32_t, 8>` pads every 1-byte size to 4
+/// bytes, and an array of `fixed_capacity_vector<std::uint64_t, 8>` to 8.
+#include <cstdint>
+#include <cstdio>
+#include <experimental/fixed_capacity_vector>
+#include <experimental/fixed_capacity_vector_array>
+#include <memory>
+#include <vector>
+#include "utils.hpp"
+
+constexpr std::size_t capacity = 8;
+
+/// Pseudo-random size of the \p i-th vector in [0, capacity].
+std::size_t size_of(std::size_t i)
+{
+    return (i * 2654435761u >> 7) % (capacity + 1);
+}
+
+template <typename T, std::size_t N>
+void bench_layouts(bench::runner& r, char const* element)
+{
+    using vector = std::experimental::fixed_capacity_vector<T, capacity>;
+    using array
+        = std::experimental::fixed_capacity_vector_array<T, capacity, N>;
+    std::fprintf(stderr,
+                 "# %s: %zu bytes per vector in an array of "
+                 "fixed_capacity_vector, %zu in fixed_capacity_vector_array\n",
+                 element, sizeof(vector), sizeof(array) / N);
+
+    {
+        std::vector<vector> vs(N);
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            vs[i].resize(size_of(i), T(i));
+        }
+        r.run("vector_array", "scan", "fixed_capacity_vector", element,
+              capacity, N, N, [&] {
+                  T sum = 0;
+                  for (auto const& v : vs)
+                  {
+                      for (T x : v)
+                      {
+                          sum += x;
+                      }
+                  }
+                  bench::do_not_optimize(sum);
+              });
+        r.run("vector_array", "degree", "fixed_capacity_vector", element,
+              capacity, N, N, [&] {
+                  std::size_t sum = 0;
+                  for (auto const& v : vs)
+                  {
+                      sum += v.size();
+                  }
+                  bench::do_not_optimize(sum);
+              });
+    }
+    {
+        auto a = std::make_unique<array>();
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            (*a)[i].resize(size_of(i), T(i));
+        }
+        array const& ca = *a;
+        r.run("vector_array", "scan", "fixed_capacity_vector_array", element,
+              capacity, N, N, [&] {
+                  T sum = 0;
+                  for (auto v : ca)
+                  {
+                      for (T x : v)
+                      {
+                          sum += x;
+                      }
+                  }
+                  bench::do_not_optimize(sum);
+              });
+        r.run("vector_array", "scan", "fixed_capacity_vector_array/raw",
+              element, capacity, N, N, [&] {
+                  T sum          = 0;
+                  T const* slots = ca.data();
+                  auto sizes     = ca.sizes();
+                  for (std::size_t i = 0; i != N; ++i, slots += capacity)
+                  {
+                      for (std::size_t j = 0; j != sizes[i]; ++j)
+                      {
+                          sum += slots[j];
+                      }
+                  }
+                  bench::do_not_optimize(sum);
+              });
+        r.run("vector_array", "degree", "fixed_capacity_vector_array",
+              element, capacity, N, N, [&] {
+                  std::size_t sum = 0;
+                  auto sizes      = ca.sizes();
+                  for (std::size_t i = 0; i != N; ++i)
+                  {
+                      sum += sizes[i];
+                  }
+                  bench::do_not_optimize(sum);
+              });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_layouts<std::uint32_t, 1024>(r, "uint32");
+    bench_layouts<std::uint32_t, 1048576>(r, "uint32");
+    bench_layouts<std::uint64_t, 1048576>(r, "uint64");
+    return 0;
+}
@@ -0,0 +1,103 @@
+/// \file
+///
+/// Benchmarks `std::experimental::sort` against `std::sort` on full
+/// `fixed_capacity_vector<int, Capacity>`s of pseudo-random values, for
+/// capacities 4 to 64, e.g., top-k candidate lists.
+///
+/// Every call restores 1024 vectors from a copy and sorts them (or partially
+/// sorts their 4 smallest elements, or selects their median); the time is
+/// per vector. `copy` measures the restoring alone. Vectors of up to 16
+/// elements are sorted by a sorting network for their size, and `sort` and
+/// `nth_element` sort those of up to 64 with the networks for 32 and 64
+/// elements; `partial_sort` of larger vectors is `std::partial_sort`.
+#include <algorithm>
+#include <cstdint>
+#include <experimental/fixed_capacity_vector_sort>
+#include <vector>
+#include "utils.hpp"
+
+template <std::size_t Capacity>
+void bench_sort(bench::runner& r)
+{
+    using V                 = std::experimental::fixed_capacity_vector<int,
+                                                       Capacity>;
+    constexpr std::size_t n = 1024;
+    char const* suite       = "sort";
+    char const* c           = "fixed_capacity_vector";
+    std::vector<V> src(n), vs(n);
+    std::uint32_t x = 1;
+    for (auto& v : src)
+    {
+        for (std::size_t i = 0; i != Capacity; ++i)
+        {
+            x = x * 1664525u + 1013904223u;
+            v.push_back(static_cast<int>(x >> 8));
+        }
+    }
+
+    r.run(suite, "copy", c, "int", Capacity, Capacity, n, [&] {
+        vs = src;
+        bench::do_not_optimize(vs.data());
+    });
+    r.run(suite, "std::sort", c, "int", Capacity, Capacity, n, [&] {
+        vs = src;
+        for (auto& v : vs)
+        {
+            std::sort(v.begin(), v.end());
+        }
+        bench::do_not_optimize(vs.data());
+    });
+    r.run(suite, "sort", c, "int", Capacity, Capacity, n, [&] {
+        vs = src;
+        for (auto& v : vs)
+        {
+            std::experimental::sort(v);
+        }
+        bench::do_not_optimize(vs.data());
+    });
+    r.run(suite, "partial_sort/4", c, "int", Capacity, Capacity, n, [&] {
+        vs = src;
+        for (auto& v : vs)
+        {
+            std::experimental::partial_sort(v, v.begin() + 4);
+        }
+        bench::do_not_optimize(vs.data());
+    });
+    r.run(suite, "std::partial_sort/4", c, "int", Capacity, Capacity, n, [&] {
+        vs = src;
+        for (auto& v : vs)
+        {
+            std::partial_sort(v.begin(), v.begin() + 4, v.end());
+        }
+        bench::do_not_optimize(vs.data());
+    });
+    r.run(suite, "nth_element/half", c, "int", Capacity, Capacity, n, [&] {
+        vs = src;
+        for (auto& v : vs)
+        {
+            std::experimental::nth_element(v, v.begin() + Capacity / 2);
+        }
+        bench::do_not_optimize(vs.data());
+    });
+    r.run(suite, "std::nth_element/half", c, "int", Capacity, Capacity, n,
+          [&] {
+              vs = src;
+              for (auto& v : vs)
+              {
+                  std::nth_element(v.begin(), v.begin() + Capacity / 2,
+                                   v.end());
+              }
+              bench::do_not_optimize(vs.data());
+          });
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_sort<4>(r);
+    bench_sort<8>(r);
+    bench_sort<16>(r);
+    bench_sort<32>(r);
+    bench_sort<64>(r);
+    return 0;
+}
@@ -0,0 +1,101 @@
+/// \file
+///
+/// Benchmarks small_vector against fixed_capacity_vector and std::vector.
+///
+/// Every benchmark builds short-lived vectors of `size` elements with inline
+/// capacity 16: sizes up to 16 take the fast path (no allocation), larger
+/// sizes spill to the heap. fixed_capacity_vector is only run where the
+/// elements fit.
+#include <experimental/fixed_capacity_vector>
+#include <experimental/small_vector>
+#include <utility>
+#include "utils.hpp"
+
+constexpr std::size_t inline_capacity = 16;
+
+template <typename T>
+using small_vector = std::experimental::small_vector<T, inline_capacity>;
+
+template <typename T>
+using fixed_vector
+    = std::experimental::fixed_capacity_vector<T, inline_capacity>;
+
+template <typename V>
+struct container_traits;
+
+template <typename T>
+struct container_traits<small_vector<T>>
+{
+    static constexpr char const* name = "small_vector";
+};
+
+template <typename T>
+struct container_traits<fixed_vector<T>>
+{
+    static constexpr char const* name = "fixed_capacity_vector";
+};
+
+template <typename T>
+struct container_traits<std::vector<T>>
+{
+    static constexpr char const* name = "std::vector";
+};
+
+template <typename V>
+void bench_size(bench::runner& r, char const* storage, std::size_t n)
+{
+    using T           = typename V::value_type;
+    char const* suite = "small_vector";
+    char const* c     = container_traits<V>::name;
+
+    // push_back n elements into a new vector
+    r.run(suite, "build", c, storage, inline_capacity, n, 1, [&] {
+        V v;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            v.push_back(T(static_cast<int>(i)));
+        }
+        bench::do_not_optimize(v);
+    });
+    {  // copy a vector of n elements
+        V a;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            a.push_back(T(static_cast<int>(i)));
+        }
+        r.run(suite, "copy_construct", c, storage, inline_capacity, n, 1, [&] {
+            V b(a);
+            bench::do_not_optimize(b);
+        });
+        r.run(suite, "iterate", c, storage, inline_capacity, n, 1, [&] {
+            int sum = 0;
+            for (auto const& x : a)
+            {
+                sum += static_cast<int>(x == T(3));
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+}
+
+template <typename T>
+void bench_type(bench::runner& r, char const* storage)
+{
+    for (std::size_t n : {std::size_t{4}, std::size_t{16}, std::size_t{64}})
+    {
+        bench_size<small_vector<T>>(r, storage, n);
+        if (n <= inline_capacity)
+        {
+            bench_size<fixed_vector<T>>(r, storage, n);
+        }
+        bench_size<std::vector<T>>(r, storage, n);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bench::runner r(argc, argv);
+    bench_type<bench::trivial_t>(r, "trivial");
+    bench_type<bench::non_trivial_t>(r, "non_trivial");
+    return 0;
+}
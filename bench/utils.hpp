@@ -0,0 +1,240 @@
+#pragma once
+/// \file
+///
+/// Minimal micro-benchmark harness.
+///
+/// Every measurement is reported as one CSV line on stdout:
+///
+///   suite,benchmark,container,storage,capacity,size,ns_per_op,iterations,
+///   allocs_per_op
+///
+/// so that the output of different runs can be diffed or loaded into a
+/// spreadsheet. The first command-line argument, if any, is a substring filter
+/// on `suite/benchmark/container/storage/capacity`.
+///
+/// `allocs_per_op` counts calls to the global `operator new`, which this
+/// header replaces. Every benchmark is a single translation unit, so this
+/// header is included exactly once per program.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace bench
+{
+    /// Number of calls to the global `operator new` so far.
+    inline std::atomic<std::size_t> allocation_count{0};
+
+    /// Prevents the optimizer from discarding the computation of \p value.
+    ///
+    /// Objects larger than a register are passed in memory: with an "r,m"
+    /// constraint GCC may copy them into a temporary first, which would be
+    /// measured too.
+    template <typename T>
+    inline void do_not_optimize(T const& value)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>
+                      and sizeof(T) <= sizeof(void*))
+        {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+        else
+        {
+            asm volatile("" : : "m"(value) : "memory");
+        }
+    }
+
+    /// Prevents the optimizer from reordering memory accesses across this
+    /// point.
+    inline void clobber_memory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    /// Trivial element type (selects `storage::trivial`).
+    using trivial_t = int;
+
+    /// Non-trivial element type with the same payload as `trivial_t`
+    /// (selects `storage::non_trivial`).
+    struct non_trivial_t
+    {
+        int value = 0;
+
+        non_trivial_t() noexcept
+        {
+        }
+        non_trivial_t(int v) noexcept : value(v)
+        {
+        }
+        non_trivial_t(non_trivial_t const& o) noexcept : value(o.value)
+        {
+        }
+        non_trivial_t& operator=(non_trivial_t const& o) noexcept
+        {
+            value = o.value;
+            return *this;
+        }
+        ~non_trivial_t()
+        {
+        }
+
+        friend bool operator==(non_trivial_t const& a, non_trivial_t const& b)
+        {
+            return a.value == b.value;
+        }
+        friend bool operator<(non_trivial_t const& a, non_trivial_t const& b)
+        {
+            return a.value < b.value;
+        }
+        friend bool operator<=(non_trivial_t const& a, non_trivial_t const& b)
+        {
+            return a.value <= b.value;
+        }
+        friend bool operator>(non_trivial_t const& a, non_trivial_t const& b)
+        {
+            return a.value > b.value;
+        }
+        friend bool operator>=(non_trivial_t const& a, non_trivial_t const& b)
+        {
+            return a.value >= b.value;
+        }
+    };
+
+    static_assert(!std::is_trivial<non_trivial_t>{});
+
+    /// Raw, suitably aligned heap memory for one object of type `T`.
+    ///
+    /// Large-capacity vectors do not fit comfortably on the stack, and
+    /// construction benchmarks need memory in which to placement-new.
+    template <typename T>
+    struct buffer
+    {
+        std::unique_ptr<std::aligned_storage_t<sizeof(T), alignof(T)>> raw
+            = std::make_unique<
+                std::aligned_storage_t<sizeof(T), alignof(T)>>();
+
+        void* get() noexcept
+        {
+            return raw.get();
+        }
+    };
+
+    /// Harness configuration and result printer.
+    struct runner
+    {
+        /// Minimum wall-clock time of a single sample.
+        std::chrono::nanoseconds min_sample_time
+            = std::chrono::milliseconds(5);
+        /// Number of samples per measurement (the fastest one is reported).
+        int samples = 5;
+        /// Substring filter on the benchmark id.
+        std::string filter;
+
+        runner(int argc, char** argv)
+        {
+            if (argc > 1)
+            {
+                filter = argv[1];
+            }
+            std::printf(
+                "suite,benchmark,container,storage,capacity,size,ns_per_op,"
+                "iterations,allocs_per_op\n");
+        }
+
+        /// Times \p f, which performs \p ops_per_call operations per call, and
+        /// prints the result.
+        template <typename F>
+        void run(char const* suite, char const* benchmark,
+                 char const* container, char const* storage,
+                 std::size_t capacity, std::size_t size,
+                 std::size_t ops_per_call, F&& f)
+        {
+            std::string id = std::string(suite) + "/" + benchmark + "/"
+                             + container + "/" + storage + "/"
+                             + std::to_string(capacity);
+            if (!filter.empty() && id.find(filter) == std::string::npos)
+            {
+                return;
+            }
+
+            using clock = std::chrono::steady_clock;
+            // Calibrate: double the number of calls until one sample takes
+            // at least min_sample_time.
+            std::size_t calls = 1;
+            for (;;)
+            {
+                auto t0 = clock::now();
+                for (std::size_t i = 0; i != calls; ++i)
+                {
+                    f();
+                }
+                auto t1 = clock::now();
+                if (t1 - t0 >= min_sample_time
+                    || calls >= (std::size_t{1} << 30))
+                {
+                    break;
+                }
+                calls *= 2;
+            }
+
+            double best        = std::numeric_limits<double>::max();
+            std::size_t allocs = 0;
+            for (int s = 0; s != samples; ++s)
+            {
+                std::size_t a0 = allocation_count.load();
+                auto t0        = clock::now();
+                for (std::size_t i = 0; i != calls; ++i)
+                {
+                    f();
+                }
+                auto t1 = clock::now();
+                allocs  = allocation_count.load() - a0;
+                double ns
+                    = std::chrono::duration<double, std::nano>(t1 - t0).count();
+                best = std::min(best, ns / double(calls * ops_per_call));
+            }
+
+            std::printf("%s,%s,%s,%s,%zu,%zu,%.3f,%zu,%.3f\n", suite,
+                        benchmark, container, storage, capacity, size, best,
+                        calls * ops_per_call,
+                        double(allocs) / double(calls * ops_per_call));
+            std::fflush(stdout);
+        }
+    };
+
+}  // namespace bench
+
+/// \name Counting replacements of the global allocation functions
+///
+/// Not inlined, like the library ones: otherwise GCC sees `free` called on
+/// memory returned by `operator new` and warns (-Wmismatched-new-delete).
+///@{
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    ++bench::allocation_count;
+    if (void* p = std::malloc(size != 0 ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+///@}
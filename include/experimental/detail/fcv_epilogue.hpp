@@ -0,0 +1,17 @@
+/// \file
+///
+/// Undefines the internal macros defined by `fcv_prologue.hpp`.
+///
+/// This file intentionally has no include guard.
+
+// undefine all the internal macros
+#undef FCV_UNREACHABLE
+#undef FCV_ASSUME
+#undef FCV_ASSERT
+#undef FCV_LIKELY
+#undef FCV_UNLIKELY
+#undef FCV_EXPECT
+#undef FCV_CONCEPT_PP_CAT_
+#undef FCV_CONCEPT_PP_CAT
+#undef FCV_REQUIRES_
+#undef FCV_REQUIRES
@@ -0,0 +1,60 @@
+/// \file
+///
+/// Defines the internal macros of the fixed_capacity_vector family of
+/// headers. Every public header includes this file before its contents and
+/// `fcv_epilogue.hpp` after them, so that no macro leaks to users.
+///
+/// This file intentionally has no include guard.
+///
+/// Copyright Gonzalo Brito Gadeschi 2015-2017
+///
+/// This file is released under the Boost Software License (see
+/// `<experimental/fixed_capacity_vector>`).
+
+/// Unreachable code
+#define FCV_UNREACHABLE __builtin_unreachable()
+
+/// Optimizer allowed to assume that EXPR evaluates to true
+#define FCV_ASSUME(EXPR) \
+    static_cast<void>((EXPR) ? void(0) : __builtin_unreachable())
+
+/// Assert pretty printer
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+/// Likely/unlikely branches
+#define FCV_LIKELY(boolean_expr) __builtin_expect(!!(boolean_expr), 1)
+#define FCV_UNLIKELY(boolean_expr) __builtin_expect(!!(boolean_expr), 0)
+
+/// Expect asserts the condition in debug builds and assumes the condition to be
+/// true in release builds.
+#ifdef NDEBUG
+#define FCV_EXPECT(EXPR) FCV_ASSUME(EXPR)
+#else
+#define FCV_EXPECT(EXPR) FCV_ASSERT(EXPR)
+#endif
+
+#define FCV_CONCEPT_PP_CAT_(X, Y) X##Y
+#define FCV_CONCEPT_PP_CAT(X, Y) FCV_CONCEPT_PP_CAT_(X, Y)
+
+/// Requires-clause emulation with SFINAE (for templates)
+#define FCV_REQUIRES_(...)                                                 \
+    int FCV_CONCEPT_PP_CAT(_concept_requires_, __LINE__)                   \
+        = 42,                                                              \
+        typename ::std::enable_if                                          \
+                < (FCV_CONCEPT_PP_CAT(_concept_requires_, __LINE__) == 43) \
+            || (__VA_ARGS__),                                              \
+        int > ::type = 0 /**/
+
+/// Requires-clause emulation with SFINAE (for "non-templates")
+#define FCV_REQUIRES(...)                                                  \
+    template <int FCV_CONCEPT_PP_CAT(_concept_requires_, __LINE__) = 42,   \
+              typename ::std::enable_if<                                   \
+                  (FCV_CONCEPT_PP_CAT(_concept_requires_, __LINE__) == 43) \
+                      || (__VA_ARGS__),                                    \
+                  int>::type                                               \
+              = 0> /**/
@@ -0,0 +1,173 @@
+/// \file
+///
+/// Test for concurrent_fixed_capacity_vector
+
+#include <algorithm>
+#include <experimental/concurrent_fixed_capacity_vector>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::concurrent_fixed_capacity_vector;
+
+// trivial:
+template struct std::experimental::concurrent_fixed_capacity_vector<int, 8>;
+
+// non-trivial
+template struct std::experimental::concurrent_fixed_capacity_vector<
+    std::string, 4>;
+
+// move-only:
+template struct std::experimental::concurrent_fixed_capacity_vector<
+    std::unique_ptr<int>, 4>;
+
+/// Counts the live instances.
+struct counted
+{
+    static inline int live = 0;
+    int value              = 0;
+    counted() noexcept
+    {
+        ++live;
+    }
+    counted(int v) noexcept : value(v)
+    {
+        ++live;
+    }
+    counted(counted const& o) noexcept : value(o.value)
+    {
+        ++live;
+    }
+    ~counted()
+    {
+        --live;
+    }
+};
+
+int main()
+{
+    {  // single thread
+        concurrent_fixed_capacity_vector<int, 8> v;
+        static_assert(concurrent_fixed_capacity_vector<int, 8>::capacity()
+                      == 8);
+        FCV_ASSERT(!v.frozen());
+        int* p = v.try_push_back(1);
+        FCV_ASSERT(p != nullptr && *p == 1);
+        FCV_ASSERT(*v.try_emplace_back(2) == 2);
+        const int a[] = {3, 4, 5};
+        FCV_ASSERT(v.grow_by(a, 3) == p + 2);
+        FCV_ASSERT(v.grow_by(2) == p + 5);
+        FCV_ASSERT(v.grow_by(2) == nullptr);  // does not fit
+        FCV_ASSERT(v.try_push_back(8) == nullptr);  // the vector is full
+        FCV_ASSERT(v.freeze() == 7 && v.frozen() && v.freeze() == 7);
+        const int expected[] = {1, 2, 3, 4, 5, 0, 0};
+        FCV_ASSERT(std::equal(v.begin(), v.end(), expected, expected + 7));
+        FCV_ASSERT(v.try_push_back(9) == nullptr);  // frozen
+
+        v.clear();
+        FCV_ASSERT(!v.frozen());
+        std::vector<int> l = {6, 7};
+        FCV_ASSERT(v.grow_by(l.begin(), 2) != nullptr);
+        FCV_ASSERT(v.freeze() == 2 && v[0] == 6 && v[1] == 7);
+    }
+
+    {  // exactly full
+        concurrent_fixed_capacity_vector<int, 2> v;
+        FCV_ASSERT(v.try_push_back(1) && v.try_push_back(2));
+        FCV_ASSERT(v.freeze() == 2);
+    }
+
+    {  // non-trivial elements are destroyed
+        {
+            concurrent_fixed_capacity_vector<counted, 4> v;
+            v.try_emplace_back(1);
+            v.grow_by(2);
+            FCV_ASSERT(counted::live == 3);
+            v.clear();
+            FCV_ASSERT(counted::live == 0);
+            v.grow_by(4);
+        }
+        FCV_ASSERT(counted::live == 0);
+
+        concurrent_fixed_capacity_vector<std::unique_ptr<int>, 2> u;
+        u.try_push_back(std::make_unique<int>(1));
+        u.try_emplace_back(new int(2));
+        FCV_ASSERT(u.freeze() == 2 && *u[1] == 2);
+    }
+
+    {  // many producers, per element and per batch
+        constexpr int threads = 4;
+        constexpr int per     = 2000;
+        concurrent_fixed_capacity_vector<int, threads * per + 100> v;
+        std::vector<std::thread> producers;
+        for (int t = 0; t != threads; ++t)
+        {
+            producers.emplace_back([&v, t] {
+                if (t % 2 == 0)
+                {
+                    for (int i = 0; i != per; ++i)
+                    {
+                        v.try_push_back(t * per + i);
+                    }
+                }
+                else
+                {
+                    int batch[50];
+                    for (int i = 0; i != per; i += 50)
+                    {
+                        for (int j = 0; j != 50; ++j)
+                        {
+                            batch[j] = t * per + i + j;
+                        }
+                        v.grow_by(batch, 50);
+                    }
+                }
+            });
+        }
+        // the consumer can freeze while the producers still run
+        std::thread overflow([&v] {
+            while (v.try_push_back(-1) != nullptr)
+            {
+            }
+        });
+        for (auto& p : producers)
+        {
+            p.join();
+        }
+        overflow.join();
+        v.freeze();
+        std::vector<int> r(v.begin(), v.end());
+        r.erase(std::remove(r.begin(), r.end(), -1), r.end());
+        std::sort(r.begin(), r.end());
+        bool all = r.size() <= std::size_t{threads * per};
+        for (std::size_t i = 0; all && i != r.size(); ++i)
+        {
+            all = i == 0 || r[i] > r[i - 1];
+        }
+        FCV_ASSERT(all && v.size() == v.capacity());
+    }
+
+    {  // freeze while producers are running
+        concurrent_fixed_capacity_vector<int, 100000> v;
+        std::thread producer([&v] {
+            while (v.try_push_back(1) != nullptr)
+            {
+            }
+        });
+        const std::size_t n = v.freeze();
+        producer.join();
+        FCV_ASSERT(n == v.size()
+                   && std::count(v.begin(), v.end(), 1)
+                          == static_cast<std::ptrdiff_t>(n));
+    }
+
+    return 0;
+}
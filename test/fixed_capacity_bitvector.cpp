@@ -0,0 +1,267 @@
+/// \file
+///
+/// Test for fixed_capacity_bitvector and fixed_capacity_packed_vector
+
+#include <algorithm>
+#include <cstdint>
+#include <experimental/fixed_capacity_bitvector>
+#include <experimental/fixed_capacity_vector>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_bitvector;
+using std::experimental::fixed_capacity_packed_vector;
+
+template struct std::experimental::fixed_capacity_packed_vector<1, 100>;
+template struct std::experimental::fixed_capacity_packed_vector<2, 64>;
+template struct std::experimental::fixed_capacity_packed_vector<4, 7>;
+
+/// Index of the first element of \p v at or after \p pos for which \p p is
+/// true, or `npos`.
+template <typename P>
+std::size_t find_in(std::vector<std::uint8_t> const& v, std::size_t pos, P p)
+{
+    for (std::size_t i = pos; i < v.size(); ++i)
+    {
+        if (p(v[i]))
+        {
+            return i;
+        }
+    }
+    return static_cast<std::size_t>(-1);
+}
+
+/// Applies pseudo-random operations to a packed vector and to a
+/// `std::vector<std::uint8_t>`, and checks that the elements and the scans
+/// agree.
+template <std::size_t Bits, std::size_t Capacity>
+bool matches_vector(unsigned seed)
+{
+    using V = fixed_capacity_packed_vector<Bits, Capacity>;
+    using T = typename V::value_type;
+    V v;
+    std::vector<std::uint8_t> e;
+    std::mt19937 g(seed);
+    const unsigned values = 1u << Bits;
+    for (int round = 0; round != 3000; ++round)
+    {
+        const T x = static_cast<T>(g() % values);
+        const std::size_t i = e.empty() ? 0 : g() % e.size();
+        const std::size_t j = e.empty() ? 0 : i + g() % (e.size() - i + 1);
+        switch (g() % 10)
+        {
+            case 0:
+            case 1:
+                if (!v.full())
+                {
+                    v.push_back(x);
+                    e.push_back(x);
+                }
+                break;
+            case 2:
+                if (!v.empty())
+                {
+                    v.pop_back();
+                    e.pop_back();
+                }
+                break;
+            case 3:
+            {
+                const std::size_t n = g() % (Capacity + 1);
+                v.resize(n, x);
+                e.resize(n, x);
+                break;
+            }
+            case 4:
+                v.fill(i, j, x);
+                std::fill(e.begin() + static_cast<std::ptrdiff_t>(i),
+                          e.begin() + static_cast<std::ptrdiff_t>(j), x);
+                break;
+            case 5:
+                if (!e.empty())
+                {
+                    v[i] = x;
+                    e[i] = x;
+                }
+                break;
+            case 6:
+                v.flip();
+                for (auto& y : e)
+                {
+                    y = static_cast<std::uint8_t>(~y & (values - 1));
+                }
+                break;
+            case 7:
+            {
+                V w(e.size(), x);
+                v &= w;
+                for (auto& y : e)
+                {
+                    y = static_cast<std::uint8_t>(y & x);
+                }
+                break;
+            }
+            case 8:
+            {
+                V w(e.size(), x);
+                v ^= w;
+                for (auto& y : e)
+                {
+                    y = static_cast<std::uint8_t>(y ^ x);
+                }
+                break;
+            }
+            default:
+                if (round % 50 == 0)
+                {
+                    v.clear();
+                    e.clear();
+                }
+                break;
+        }
+
+        if (v.size() != e.size() || !std::equal(v.begin(), v.end(), e.begin()))
+        {
+            return false;
+        }
+        // the bits past the size are zero:
+        if (v.used_words() != 0)
+        {
+            const auto last = v.words()[v.used_words() - 1];
+            const std::size_t used = (v.size() * Bits - 1) % 64 + 1;
+            if (used != 64 && (last >> used) != 0)
+            {
+                return false;
+            }
+        }
+        const auto nonzero = [](std::uint8_t y) { return y != 0; };
+        const auto equal_x = [x](std::uint8_t y) { return y == x; };
+        const std::size_t nz
+            = static_cast<std::size_t>(std::count_if(e.begin(), e.end(),
+                                                     nonzero));
+        if (v.count() != nz
+            || v.count(x) != static_cast<std::size_t>(
+                                 std::count(e.begin(), e.end(), x))
+            || v.any() != (nz != 0) || v.none() != (nz == 0)
+            || v.all() != (nz == e.size())
+            || v.find_first() != find_in(e, 0, nonzero)
+            || v.find_next(i) != find_in(e, i + 1, nonzero)
+            || v.find(x, i) != find_in(e, i, equal_x))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    {  // bits
+        using B = fixed_capacity_bitvector<4096>;
+        static_assert(std::is_trivially_copyable_v<B>);
+        static_assert(std::is_same_v<B::value_type, bool>);
+        static_assert(sizeof(B) <= 4096 / 8 + 8);
+        static_assert(sizeof(fixed_capacity_packed_vector<4, 4096>)
+                      <= 4096 / 2 + 8);
+
+        fixed_capacity_bitvector<100> b = {true, false, true};
+        FCV_ASSERT(b.size() == 3 && b[0] && !b[1] && b.back());
+        b.resize(70);
+        b.set(69);
+        b.reset(0);
+        b.flip(1);
+        FCV_ASSERT(b.count() == 3 && b.find_first() == 1);
+        FCV_ASSERT(b.find_next(1) == 2 && b.find_next(2) == 69);
+        FCV_ASSERT(b.find_next(69) == b.npos && b.find(false) == 0);
+        FCV_ASSERT(b.used_words() == 2 && b.words()[1] == 0x20);
+        b.set();
+        FCV_ASSERT(b.all() && b.count() == 70 && b.find(false) == b.npos);
+        b.reset();
+        FCV_ASSERT(b.none() && !b.any() && b.size() == 70);
+        FCV_ASSERT(fixed_capacity_bitvector<100>().all());
+
+        // proxies:
+        b[5] = true;
+        b[6] = b[5];
+        b[5].flip();
+        swap(b[5], b[7]);
+        FCV_ASSERT(!b[5] && b[6] && !b[7]);
+        auto const& c = b;
+        FCV_ASSERT(c[6] && c.at(6) && std::find(c.begin(), c.end(), true)
+                                          == c.begin() + 6);
+        bool threw = false;
+        try
+        {
+            (void)b.at(70);
+        }
+        catch (std::out_of_range const&)
+        {
+            threw = true;
+        }
+        FCV_ASSERT(threw);
+
+        // iterators:
+        fixed_capacity_bitvector<16> r = {true, true, false, false, false};
+        std::reverse(r.begin(), r.end());
+        FCV_ASSERT((r == fixed_capacity_bitvector<16>{false, false, false,
+                                                       true, true}));
+        FCV_ASSERT(r.end() - r.begin() == 5 && *(r.rbegin()) == true);
+        fixed_capacity_bitvector<16>::const_iterator it = r.begin();
+        FCV_ASSERT(it == r.cbegin() && it[3] && it + 5 == r.end());
+        FCV_ASSERT((r & ~fixed_capacity_bitvector<16>(5)) == r);
+    }
+
+    {  // small integers
+        fixed_capacity_packed_vector<4, 40> n = {1, 15, 7, 0, 7};
+        static_assert(decltype(n)::max_value() == 15);
+        FCV_ASSERT(n.size() == 5 && n[1] == 15 && n[2] == 7);
+        FCV_ASSERT(n.count() == 4 && n.count(7) == 2 && n.count(0) == 1);
+        FCV_ASSERT(n.find(7) == 2 && n.find(7, 3) == 4 && n.find(9) == n.npos);
+        n.resize(20, 3);
+        n.fill(10, 20, 9);
+        FCV_ASSERT(n.count(3) == 5 && n.count(9) == 10 && n[19] == 9);
+        n[19] = 2;
+        FCV_ASSERT(n.back() == 2 && n.used_words() == 2);
+
+        fixed_capacity_packed_vector<2, 8> q(8, 2);
+        q.set(0);
+        q[7] = 1;
+        std::vector<int> seen(q.begin(), q.end());
+        FCV_ASSERT((seen == std::vector<int>{3, 2, 2, 2, 2, 2, 2, 1}));
+    }
+
+    {  // agrees with a vector of bytes
+        FCV_ASSERT((matches_vector<1, 200>(1)));
+        FCV_ASSERT((matches_vector<1, 64>(2)));
+        FCV_ASSERT((matches_vector<2, 100>(3)));
+        FCV_ASSERT((matches_vector<2, 32>(4)));
+        FCV_ASSERT((matches_vector<4, 50>(5)));
+        FCV_ASSERT((matches_vector<4, 3>(6)));
+    }
+
+    {  // constant expressions
+        constexpr auto b = [] {
+            fixed_capacity_bitvector<130> v(130);
+            v.fill(60, 70, true);
+            v.flip(129);
+            v.pop_back();
+            return v;
+        }();
+        static_assert(b.size() == 129 && b.count() == 10);
+        static_assert(b.find_first() == 60 && b.find_next(69) == b.npos);
+        constexpr fixed_capacity_packed_vector<2, 10> p = {3, 0, 3, 1};
+        static_assert(p.count(3) == 2 && p.find(1) == 3 && !p.all());
+    }
+
+    return 0;
+}
@@ -0,0 +1,295 @@
+/// \file
+///
+/// Test for fixed_capacity_flat_set and fixed_capacity_flat_map
+
+#include <algorithm>
+#include <experimental/fixed_capacity_flat_map>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_flat_map;
+using std::experimental::fixed_capacity_flat_set;
+
+// trivial:
+template struct std::experimental::fixed_capacity_flat_set<int, 8>;
+template struct std::experimental::fixed_capacity_flat_map<int, int, 8>;
+
+// non-trivial
+template struct std::experimental::fixed_capacity_flat_set<std::string, 4>;
+template struct std::experimental::fixed_capacity_flat_map<std::string,
+                                                           std::string, 4>;
+
+// custom comparison:
+template struct std::experimental::fixed_capacity_flat_set<int, 8,
+                                                           std::greater<int>>;
+
+/// Checks the lower and upper bounds of every key in [-1, 2 * n + 1] in the
+/// set of the odd numbers below 2 * n, against std::lower_bound and
+/// std::upper_bound.
+template <typename K, std::size_t N>
+bool bounds_match(std::size_t n)
+{
+    fixed_capacity_flat_set<K, N> s;
+    std::vector<K> v;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        s.insert(static_cast<K>(2 * i + 1));
+        v.push_back(static_cast<K>(2 * i + 1));
+    }
+    for (int k = -1; k <= static_cast<int>(2 * n + 1); ++k)
+    {
+        const K key = static_cast<K>(k);
+        if (s.lower_bound(key) - s.begin()
+                != std::lower_bound(v.begin(), v.end(), key) - v.begin()
+            || s.upper_bound(key) - s.begin()
+                   != std::upper_bound(v.begin(), v.end(), key) - v.begin()
+            || s.contains(key) != (k > 0 && k % 2 == 1 && k < int(2 * n)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Value whose construction from a negative number throws, and whose copy
+/// throws once `copies_left` copies were made (never if it is negative).
+struct throwing
+{
+    static inline int copies_left = -1;
+    int x;
+
+    throwing(int v) : x(v)
+    {
+        if (v < 0)
+        {
+            throw std::runtime_error("negative value");
+        }
+    }
+    throwing(throwing const& other) : x(other.x)
+    {
+        if (copies_left == 0)
+        {
+            throw std::runtime_error("too many copies");
+        }
+        if (copies_left > 0)
+        {
+            --copies_left;
+        }
+    }
+    throwing(throwing&&) noexcept = default;
+    throwing& operator=(throwing const&) = default;
+    throwing& operator=(throwing&&) noexcept = default;
+};
+
+int main()
+{
+    {  // set: insert, lookup, erase
+        fixed_capacity_flat_set<int, 8> s = {5, 1, 3, 1};
+        FCV_ASSERT(s.size() == 3 && s.capacity() == 8);
+        FCV_ASSERT(std::is_sorted(s.begin(), s.end()));
+        auto r = s.insert(2);
+        FCV_ASSERT(r.second && *r.first == 2 && r.first == s.begin() + 1);
+        r = s.insert(3);
+        FCV_ASSERT(!r.second && *r.first == 3);
+        FCV_ASSERT(s.contains(5) && !s.contains(4) && s.count(1) == 1);
+        FCV_ASSERT(s.find(4) == s.end() && *s.lower_bound(4) == 5);
+        FCV_ASSERT(*s.upper_bound(3) == 5 && s.upper_bound(5) == s.end());
+        FCV_ASSERT(s.erase(3) == 1 && s.erase(3) == 0);
+        FCV_ASSERT(*s.erase(s.begin()) == 2);
+        FCV_ASSERT((s == fixed_capacity_flat_set<int, 8>{2, 5}));
+        FCV_ASSERT(*s.rbegin() == 5);
+        s.clear();
+        FCV_ASSERT(s.empty());
+    }
+
+    {  // set: linear and binary searches agree with std::lower_bound
+        FCV_ASSERT((bounds_match<int, 256>(0)));
+        FCV_ASSERT((bounds_match<int, 256>(1)));
+        FCV_ASSERT((bounds_match<int, 256>(7)));
+        FCV_ASSERT((bounds_match<int, 256>(32)));
+        FCV_ASSERT((bounds_match<int, 256>(33)));
+        FCV_ASSERT((bounds_match<int, 256>(64)));
+        FCV_ASSERT((bounds_match<int, 256>(200)));
+        FCV_ASSERT((bounds_match<unsigned char, 128>(100)));
+        FCV_ASSERT((bounds_match<long, 300>(300)));
+    }
+
+    {  // set: custom order and non-trivial keys
+        fixed_capacity_flat_set<int, 8, std::greater<int>> g = {1, 3, 2};
+        FCV_ASSERT(*g.begin() == 3 && *g.lower_bound(2) == 2);
+        FCV_ASSERT(g.upper_bound(1) == g.end());
+
+        fixed_capacity_flat_set<std::string, 4> s;
+        s.insert(std::string("pear"));
+        s.insert("apple");
+        s.insert("fig");
+        FCV_ASSERT(*s.begin() == "apple" && s.contains("pear"));
+        FCV_ASSERT(s.erase("fig") == 1 && s.size() == 2);
+    }
+
+    {  // set: insert_sorted and merge
+        fixed_capacity_flat_set<int, 16> s = {2, 4, 6, 8};
+        const int in[] = {1, 2, 2, 3, 9, 10};
+        s.insert_sorted(in, in + 6);
+        FCV_ASSERT((s == fixed_capacity_flat_set<int, 16>{1, 2, 3, 4, 6, 8, 9,
+                                                          10}));
+        fixed_capacity_flat_set<int, 16> t = {0, 5, 10, 11};
+        s.merge(t);
+        FCV_ASSERT(s.size() == 11 && std::is_sorted(s.begin(), s.end()));
+        FCV_ASSERT(*s.begin() == 0 && *s.rbegin() == 11 && s.contains(5));
+        s.insert_sorted(in, in);  // empty range
+        FCV_ASSERT(s.size() == 11);
+
+        fixed_capacity_flat_set<int, 4> e;
+        e.insert_sorted(in + 2, in + 6);  // into an empty set
+        FCV_ASSERT((e == fixed_capacity_flat_set<int, 4>{2, 3, 9, 10}));
+
+        fixed_capacity_flat_set<std::string, 4> w = {"b", "d"};
+        const std::string ws[] = {"a", "c", "d"};
+        w.insert_sorted(ws, ws + 3);
+        FCV_ASSERT((w == fixed_capacity_flat_set<std::string, 4>{"a", "b", "c",
+                                                                 "d"}));
+    }
+
+    {  // map: lookup and modifiers
+        using map = fixed_capacity_flat_map<int, int, 8>;
+        map m = {{3, 30}, {1, 10}, {2, 20}, {1, 11}};
+        FCV_ASSERT(m.size() == 3 && m.at(1) == 10 && m.at(3) == 30);
+        FCV_ASSERT(m.keys()[0] == 1 && m.values()[2] == 30);
+        FCV_ASSERT(m.find(2)->second == 20 && m.find(4) == m.end());
+        FCV_ASSERT(m.contains(3) && m.count(4) == 0);
+        FCV_ASSERT((*m.lower_bound(2)).first == 2);
+        FCV_ASSERT(m.upper_bound(3) == m.end());
+        bool thrown = false;
+        try
+        {
+            (void)m.at(4);
+        }
+        catch (std::out_of_range&)
+        {
+            thrown = true;
+        }
+        FCV_ASSERT(thrown);
+
+        m[4] = 40;
+        m[0] += 5;
+        FCV_ASSERT(m.size() == 5 && m.at(0) == 5 && m.keys()[4] == 4);
+        auto r = m.try_emplace(2, 99);
+        FCV_ASSERT(!r.second && r.first->second == 20);
+        r = m.insert_or_assign(2, 22);
+        FCV_ASSERT(!r.second && m.at(2) == 22);
+        r = m.insert_or_assign(9, 90);
+        FCV_ASSERT(r.second && r.first->first == 9 && m.values()[5] == 90);
+        FCV_ASSERT(m.insert({5, 50}).second);
+
+        // iterators
+        int sum = 0;
+        for (auto [k, v] : m)
+        {
+            sum += k;
+            v *= 2;
+        }
+        FCV_ASSERT(sum == 0 + 1 + 2 + 3 + 4 + 5 + 9 && m.at(9) == 180);
+        map::const_iterator it = m.begin();
+        FCV_ASSERT(it == m.cbegin() && m.end() - it == 7);
+        FCV_ASSERT(it[1].second == 20 && (*m.rbegin()).first == 9);
+
+        FCV_ASSERT(m.erase(4) == 1 && m.erase(4) == 0);
+        FCV_ASSERT(m.erase(m.begin())->first == 1);
+        FCV_ASSERT(m.size() == 5 && m.keys()[0] == 1 && m.values()[0] == 20);
+
+        map n = m;
+        FCV_ASSERT(n == m);
+        n[1] = 0;
+        FCV_ASSERT(n != m);
+        swap(n, m);
+        FCV_ASSERT(m.at(1) == 0 && n.at(1) == 20);
+        m.clear();
+        FCV_ASSERT(m.empty() && m.begin() == m.end());
+    }
+
+    {  // map: insert_sorted, merge, non-trivial and move-only values
+        using map = fixed_capacity_flat_map<std::string, std::string, 4>;
+        map m     = {{"b", "2"}, {"d", "4"}};
+        const std::pair<std::string, std::string> in[]
+            = {{"a", "1"}, {"b", "x"}, {"c", "3"}};
+        m.insert_sorted(in, in + 3);
+        FCV_ASSERT(m.size() == 4 && m.at("a") == "1" && m.at("b") == "2");
+        FCV_ASSERT(m.keys()[2] == "c" && m.values()[3] == "4");
+
+        using imap = fixed_capacity_flat_map<int, int, 8>;
+        imap a     = {{1, 1}, {5, 5}, {9, 9}};
+        imap b     = {{0, 0}, {5, 50}, {7, 7}};
+        a.merge(b);
+        FCV_ASSERT((a == imap{{0, 0}, {1, 1}, {5, 5}, {7, 7}, {9, 9}}));
+
+        fixed_capacity_flat_map<int, std::unique_ptr<int>, 4> u;
+        u.try_emplace(2, new int(2));
+        u.try_emplace(1, std::make_unique<int>(1));
+        u.erase(1);
+        FCV_ASSERT(u.size() == 1 && *u.at(2) == 2);
+    }
+
+    {  // map: throwing values leave the keys and the values in sync
+        using map = fixed_capacity_flat_map<int, throwing, 8>;
+        map m;
+        m.try_emplace(1, 1);
+        m.try_emplace(5, 5);
+        bool threw = false;
+        try
+        {
+            m.try_emplace(3, -1);
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        FCV_ASSERT(threw && m.size() == 2 && m.values().size() == 2);
+        FCV_ASSERT(m.keys()[1] == 5 && m.values()[1].x == 5);
+        FCV_ASSERT(m.try_emplace(3, 3).second && m.values()[1].x == 3);
+
+        // insert_sorted copies every new value once:
+        const std::pair<int, throwing> in[] = {{0, 0}, {4, 4}};
+        throwing::copies_left               = 2;
+        m.insert_sorted(in, in + 2);
+        throwing::copies_left = -1;
+        FCV_ASSERT(m.size() == 5 && m.values().size() == 5);
+        FCV_ASSERT(m.at(0).x == 0 && m.at(4).x == 4 && m.at(5).x == 5);
+    }
+
+    {  // constant expressions
+        constexpr auto s = [] {
+            fixed_capacity_flat_set<int, 8> s = {4, 2, 6};
+            const int in[]                    = {1, 2, 7};
+            s.insert_sorted(in, in + 3);
+            s.erase(6);
+            return s;
+        }();
+        static_assert(s.size() == 4 && s.contains(7) && !s.contains(6));
+        static_assert(*s.lower_bound(3) == 4 && *s.begin() == 1);
+
+        constexpr auto m = [] {
+            fixed_capacity_flat_map<int, char, 300> m;
+            for (int i = 0; i != 300; ++i)
+            {
+                m[299 - i] = static_cast<char>(i % 100);
+            }
+            return m;
+        }();
+        static_assert(m.size() == 300 && m.at(299) == 0 && m.at(0) == 99);
+        static_assert(m.find(150)->second == 49 && !m.contains(300));
+    }
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+/// \file
+///
+/// Test for fixed_capacity_priority_queue
+
+#include <algorithm>
+#include <array>
+#include <experimental/fixed_capacity_priority_queue>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_priority_queue;
+
+// trivial:
+template struct std::experimental::fixed_capacity_priority_queue<int, 8>;
+template struct std::experimental::fixed_capacity_priority_queue<
+    int, 16, std::greater<int>, 3>;
+
+// non-trivial:
+template struct std::experimental::fixed_capacity_priority_queue<
+    std::string, 4, std::less<std::string>, 2>;
+
+/// Pushes and pops pseudo-random values in a queue and in a
+/// `std::priority_queue`, keeping the queue at most full, and checks that
+/// both have the same top.
+template <typename Queue>
+bool matches_priority_queue(unsigned seed)
+{
+    Queue q;
+    std::priority_queue<int, std::vector<int>, typename Queue::value_compare>
+        expected;
+    std::mt19937 g(seed);
+    for (int round = 0; round != 20000; ++round)
+    {
+        // grow and shrink the queue in phases, to visit every size:
+        const bool grow = (round / 500) % 2 == 0;
+        if (!q.full() && (q.empty() || g() % 4 != (grow ? 0u : 1u)))
+        {
+            const int x = static_cast<int>(g() % 1000);
+            q.push(x);
+            expected.push(x);
+        }
+        else
+        {
+            q.pop();
+            expected.pop();
+        }
+        if (q.size() != expected.size()
+            || (!q.empty() && q.top() != expected.top()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    {  // push, pop and top
+        fixed_capacity_priority_queue<int, 8> q;
+        FCV_ASSERT(q.empty() && q.capacity() == 8 && q.arity() == 4);
+        for (int x : {3, 1, 4, 1, 5, 9, 2, 6})
+        {
+            q.push(x);
+        }
+        FCV_ASSERT(q.full() && q.size() == 8 && q.top() == 9);
+        std::vector<int> popped;
+        while (!q.empty())
+        {
+            popped.push_back(q.top());
+            q.pop();
+        }
+        FCV_ASSERT((popped == std::vector<int>{9, 6, 5, 4, 3, 2, 1, 1}));
+
+        fixed_capacity_priority_queue<int, 8, std::greater<int>, 2> m
+            = {5, 3, 8};
+        m.emplace(1);
+        FCV_ASSERT(m.top() == 1 && m.size() == 4);
+        m.replace_top(7);
+        FCV_ASSERT(m.top() == 3 && m.size() == 4);
+        auto n = m;
+        n.clear();
+        swap(m, n);
+        FCV_ASSERT(m.empty() && n.size() == 4 && n.top() == 3);
+    }
+
+    {  // agrees with std::priority_queue for every arity
+        FCV_ASSERT(
+            matches_priority_queue<fixed_capacity_priority_queue<int, 64>>(1));
+        FCV_ASSERT((matches_priority_queue<fixed_capacity_priority_queue<
+                        int, 37, std::less<int>, 2>>(2)));
+        FCV_ASSERT((matches_priority_queue<fixed_capacity_priority_queue<
+                        int, 50, std::greater<int>, 3>>(3)));
+        FCV_ASSERT((matches_priority_queue<fixed_capacity_priority_queue<
+                        int, 100, std::less<int>, 8>>(4)));
+        FCV_ASSERT((matches_priority_queue<fixed_capacity_priority_queue<
+                        int, 1, std::less<int>, 4>>(5)));
+    }
+
+    {  // heapify makes a heap of any range
+        std::mt19937 g(6);
+        for (int n = 0; n != 70; ++n)
+        {
+            std::vector<int> v(static_cast<std::size_t>(n));
+            for (auto& x : v)
+            {
+                x = static_cast<int>(g() % 50);
+            }
+            fixed_capacity_priority_queue<int, 100, std::less<int>, 3> q(
+                v.begin(), v.begin() + n / 2);
+            q.heapify(v.begin() + n / 2, v.end());
+            std::sort(v.begin(), v.end(), std::greater<int>());
+            for (int x : v)
+            {
+                FCV_ASSERT(q.top() == x);
+                q.pop();
+            }
+            FCV_ASSERT(q.empty());
+        }
+    }
+
+    {  // streaming top-K selection
+        std::mt19937 g(7);
+        std::vector<int> stream(1000);
+        for (auto& x : stream)
+        {
+            x = static_cast<int>(g() % 100000);
+        }
+        fixed_capacity_priority_queue<int, 10, std::greater<int>> top10;
+        int inserted = 0;
+        for (int x : stream)
+        {
+            inserted += top10.push_or_replace_min(x);
+        }
+        FCV_ASSERT(inserted >= 10 && inserted < 200);
+        std::sort(stream.begin(), stream.end(), std::greater<int>());
+        FCV_ASSERT(top10.full() && top10.top() == stream[9]);
+        std::vector<int> kept(top10.container().begin(),
+                              top10.container().end());
+        std::sort(kept.begin(), kept.end(), std::greater<int>());
+        FCV_ASSERT(std::equal(kept.begin(), kept.end(), stream.begin()));
+
+        // the K smallest with the default comparison:
+        fixed_capacity_priority_queue<int, 3> best3;
+        for (int x : {5, 9, 1, 7, 3, 8, 2})
+        {
+            best3.push_or_replace_min(x);
+        }
+        FCV_ASSERT(best3.top() == 3);
+        FCV_ASSERT(!best3.push_or_replace_min(4) && best3.top() == 3);
+        FCV_ASSERT(best3.push_or_replace_min(0) && best3.top() == 2);
+
+        fixed_capacity_priority_queue<int, 0> none;
+        FCV_ASSERT(!none.push_or_replace_min(1) && none.empty());
+    }
+
+    {  // non-trivial and move-only elements
+        fixed_capacity_priority_queue<std::string, 4, std::less<std::string>,
+                                      2>
+            q = {"pear", "apple"};
+        q.push("zucchini");
+        q.emplace(3, 'b');
+        FCV_ASSERT(q.top() == "zucchini");
+        q.pop();
+        FCV_ASSERT(q.top() == "pear");
+        FCV_ASSERT(q.push_or_replace_min("cherry") && q.full());
+        FCV_ASSERT(!q.push_or_replace_min("zebra") && q.top() == "pear");
+        FCV_ASSERT(q.push_or_replace_min(std::string("banana")));
+        FCV_ASSERT(q.top() == "cherry" && q.size() == 4);
+
+        auto by_value = [](std::unique_ptr<int> const& a,
+                           std::unique_ptr<int> const& b) { return *a < *b; };
+        fixed_capacity_priority_queue<std::unique_ptr<int>, 4,
+                                      decltype(by_value)>
+            u(by_value);
+        for (int x : {2, 4, 1})
+        {
+            u.push(std::make_unique<int>(x));
+        }
+        u.replace_top(std::make_unique<int>(0));
+        FCV_ASSERT(*u.top() == 2);
+        auto v = std::move(u);
+        v.pop();
+        FCV_ASSERT(*v.top() == 1 && v.size() == 2);
+    }
+
+    {  // constant expressions
+        constexpr auto sorted = [] {
+            fixed_capacity_priority_queue<int, 8, std::greater<int>> q
+                = {7, 2, 9, 4};
+            const int more[] = {8, 1, 5};
+            q.heapify(more, more + 3);
+            q.push_or_replace_min(3);
+            q.push_or_replace_min(6);
+            std::array<int, 8> a{};
+            for (auto& x : a)
+            {
+                x = q.top();
+                q.pop();
+            }
+            return a;
+        }();
+        static_assert(sorted[0] == 2 && sorted[1] == 3 && sorted[2] == 4
+                      && sorted[3] == 5);
+        static_assert(sorted[4] == 6 && sorted[5] == 7 && sorted[6] == 8
+                      && sorted[7] == 9);
+    }
+
+    return 0;
+}
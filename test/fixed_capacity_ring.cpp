@@ -0,0 +1,229 @@
+/// \file
+///
+/// Test for fixed_capacity_ring and fixed_capacity_deque
+
+#include <algorithm>
+#include <experimental/fixed_capacity_ring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_deque;
+using std::experimental::fixed_capacity_ring;
+
+// trivial:
+template struct std::experimental::fixed_capacity_ring<int, 8>;
+template struct std::experimental::fixed_capacity_deque<int, 8>;
+
+// non-trivial
+template struct std::experimental::fixed_capacity_ring<std::string, 4>;
+template struct std::experimental::fixed_capacity_deque<std::string, 4>;
+
+// move-only:
+template struct std::experimental::fixed_capacity_ring<std::unique_ptr<int>,
+                                                       4>;
+template struct std::experimental::fixed_capacity_deque<std::unique_ptr<int>,
+                                                        4>;
+
+/// Counts the live instances.
+struct counted
+{
+    static inline int live = 0;
+    int value;
+    counted(int v) noexcept : value(v)
+    {
+        ++live;
+    }
+    counted(counted const& o) noexcept : value(o.value)
+    {
+        ++live;
+    }
+    counted& operator=(counted const&) = default;
+    ~counted()
+    {
+        --live;
+    }
+};
+
+int main()
+{
+    {  // ring: single thread
+        fixed_capacity_ring<int, 4> r;
+        static_assert(fixed_capacity_ring<int, 4>::capacity() == 4);
+        static_assert(alignof(fixed_capacity_ring<int, 4>)
+                      >= std::experimental::fcv_detail::cache_line_size);
+        FCV_ASSERT(r.empty() && r.front() == nullptr);
+        int out = 0;
+        FCV_ASSERT(!r.try_pop(out));
+        for (int i = 0; i != 4; ++i)
+        {
+            FCV_ASSERT(r.try_push(i));
+        }
+        FCV_ASSERT(!r.try_push(4) && r.size() == 4);
+        FCV_ASSERT(r.try_pop(out) && out == 0);
+        FCV_ASSERT(r.try_emplace(4));
+        for (int i = 1; i != 5; ++i)  // wraps around
+        {
+            FCV_ASSERT(r.front() != nullptr && *r.front() == i);
+            r.pop();
+        }
+        FCV_ASSERT(r.empty());
+    }
+
+    {  // ring: batches wrap around
+        fixed_capacity_ring<int, 8> r;
+        const int in[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        int out[10]    = {};
+        FCV_ASSERT(r.try_push_n(in, 5) == 5);
+        FCV_ASSERT(r.try_pop_n(out, 3) == 3);
+        FCV_ASSERT(out[0] == 0 && out[2] == 2);
+        FCV_ASSERT(r.try_push_n(in + 5, 5) == 5);  // 7 elements, wraps
+        FCV_ASSERT(r.try_push_n(in, 3) == 1);      // only one fits
+        FCV_ASSERT(r.try_pop_n(out, 10) == 8);
+        const int expected[] = {3, 4, 5, 6, 7, 8, 9, 0};
+        FCV_ASSERT(std::equal(out, out + 8, expected));
+
+        std::vector<int> v;
+        std::vector<int> l = {1, 2, 3};
+        FCV_ASSERT(r.try_push_n(l.begin(), 3) == 3);
+        FCV_ASSERT(r.try_pop_n(std::back_inserter(v), 8) == 3);
+        FCV_ASSERT(v == l);
+    }
+
+    {  // ring: non-trivial and move-only elements
+        {
+            fixed_capacity_ring<counted, 4> r;
+            const counted c[] = {counted(1), counted(2), counted(3)};
+            FCV_ASSERT(r.try_push_n(c, 3) == 3);
+            FCV_ASSERT(counted::live == 6);
+            FCV_ASSERT(r.front()->value == 1);
+            r.pop();
+            FCV_ASSERT(counted::live == 5);
+        }  // the destructor destroys the remaining elements
+        FCV_ASSERT(counted::live == 0);
+
+        fixed_capacity_ring<std::unique_ptr<int>, 2> r;
+        FCV_ASSERT(r.try_push(std::make_unique<int>(1)));
+        FCV_ASSERT(r.try_emplace(new int(2)));
+        FCV_ASSERT(!r.try_push(std::make_unique<int>(3)));
+        std::unique_ptr<int> p;
+        FCV_ASSERT(r.try_pop(p) && *p == 1);
+        std::unique_ptr<int> ps[2];
+        FCV_ASSERT(r.try_pop_n(ps, 2) == 1 && *ps[0] == 2);
+    }
+
+    {  // ring: one producer and one consumer thread
+        constexpr int n = 100000;
+        fixed_capacity_ring<int, 64> r;
+        std::thread producer([&] {
+            int next = 0;
+            int batch[7];
+            while (next != n)
+            {
+                int k = 0;
+                for (; k != 7 && next + k != n; ++k)
+                {
+                    batch[k] = next + k;
+                }
+                next += static_cast<int>(
+                    r.try_push_n(batch, static_cast<std::size_t>(k)));
+            }
+        });
+        int expected = 0;
+        bool ordered = true;
+        while (expected != n)
+        {
+            int out[5];
+            const auto k = r.try_pop_n(out, 5);
+            for (std::size_t i = 0; i != k; ++i)
+            {
+                ordered = ordered && out[i] == expected++;
+            }
+        }
+        producer.join();
+        FCV_ASSERT(ordered && r.empty());
+    }
+
+    {  // deque: push and pop at both ends
+        fixed_capacity_deque<int, 4> d;
+        FCV_ASSERT(d.empty() && d.capacity() == 4);
+        d.push_back(1);
+        d.push_front(0);
+        d.push_back(2);
+        d.emplace_front(-1);
+        FCV_ASSERT(d.full() && d.front() == -1 && d.back() == 2);
+        FCV_ASSERT((d == fixed_capacity_deque<int, 4>{-1, 0, 1, 2}));
+        d.pop_front();
+        d.pop_front();
+        d.push_back(3);
+        d.push_back(4);  // wraps around
+        FCV_ASSERT((d == fixed_capacity_deque<int, 4>{1, 2, 3, 4}));
+        FCV_ASSERT(d[0] == 1 && d.at(3) == 4);
+        bool thrown = false;
+        try
+        {
+            (void)d.at(4);
+        }
+        catch (std::out_of_range&)
+        {
+            thrown = true;
+        }
+        FCV_ASSERT(thrown);
+
+        // iterators
+        int sum = 0;
+        for (int x : d)
+        {
+            sum += x;
+        }
+        FCV_ASSERT(sum == 10);
+        FCV_ASSERT(d.end() - d.begin() == 4 && d.begin()[2] == 3);
+        FCV_ASSERT(*d.rbegin() == 4 && *(d.rend() - 1) == 1);
+        fixed_capacity_deque<int, 4>::const_iterator it = d.begin();
+        FCV_ASSERT(it == d.cbegin() && it < d.cend());
+        std::sort(d.begin(), d.end(), [](int a, int b) { return a > b; });
+        FCV_ASSERT((d == fixed_capacity_deque<int, 4>{4, 3, 2, 1}));
+
+        // copies start at the first slot
+        fixed_capacity_deque<int, 4> e = d;
+        FCV_ASSERT(e == d);
+        e.pop_back();
+        FCV_ASSERT(e < d && d > e && e != d);
+        swap(d, e);
+        FCV_ASSERT(d.size() == 3 && e.size() == 4);
+    }
+
+    {  // deque: non-trivial and move-only elements
+        fixed_capacity_deque<std::string, 2> d;
+        d.push_back("a string too long for the small buffer");
+        d.push_front("b");
+        auto e = d;
+        d.pop_back();
+        d.push_front("c");
+        FCV_ASSERT((d == fixed_capacity_deque<std::string, 2>{"c", "b"}));
+        auto f = std::move(e);
+        FCV_ASSERT(f[1] == "a string too long for the small buffer");
+        f = d;
+        FCV_ASSERT(f == d);
+        f.clear();
+        FCV_ASSERT(f.empty());
+
+        fixed_capacity_deque<std::unique_ptr<int>, 2> u;
+        u.push_front(std::make_unique<int>(1));
+        u.emplace_front(new int(0));
+        auto w = std::move(u);
+        FCV_ASSERT(*w.front() == 0 && *w.back() == 1);
+        static_assert(!std::is_copy_constructible<
+                      fixed_capacity_deque<std::unique_ptr<int>, 2>>{});
+    }
+
+    return 0;
+}
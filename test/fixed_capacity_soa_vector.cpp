@@ -0,0 +1,157 @@
+/// \file
+///
+/// Test for fixed_capacity_soa_vector
+
+#include <algorithm>
+#include <cstdint>
+#include <experimental/fixed_capacity_soa_vector>
+#include <tuple>
+#include <type_traits>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_soa_vector;
+
+template struct std::experimental::fixed_capacity_soa_vector<8, int>;
+template struct std::experimental::fixed_capacity_soa_vector<8, float, int,
+                                                             char>;
+template struct std::experimental::fixed_capacity_soa_vector<300, double,
+                                                             std::uint8_t>;
+
+using soa = fixed_capacity_soa_vector<8, float, int>;
+
+/// Are the fields of \p v equal to \p xs and \p ids?
+template <std::size_t N>
+bool fields_are(soa const& v, float const (&xs)[N], int const (&ids)[N])
+{
+    return v.size() == N && std::equal(xs, xs + N, v.data<0>())
+           && std::equal(ids, ids + N, v.data<1>());
+}
+
+int main()
+{
+    {  // layout
+        static_assert(soa::capacity() == 8 && soa::max_size() == 8);
+        static_assert(soa::column_alignment<0> == 64);
+        static_assert(std::is_same_v<soa::value_type, std::tuple<float, int>>);
+        static_assert(std::is_same_v<soa::reference, std::tuple<float&, int&>>);
+        static_assert(std::is_same_v<soa::field_type<1>, int>);
+        soa v;
+        FCV_ASSERT(v.empty() && v.size() == 0);
+        FCV_ASSERT(reinterpret_cast<std::uintptr_t>(v.data<0>()) % 64 == 0);
+        FCV_ASSERT(reinterpret_cast<std::uintptr_t>(v.data<1>()) % 64 == 0);
+    }
+
+    {  // push_back, element access, iterators
+        soa v;
+        v.push_back({1.f, 10});
+        v.emplace_back(2.f, 20);
+        auto r = v.emplace_back(3, 30);  // converts int to float
+        FCV_ASSERT(std::get<0>(r) == 3.f && std::get<1>(r) == 30);
+        FCV_ASSERT(fields_are(v, {1.f, 2.f, 3.f}, {10, 20, 30}));
+
+        auto [x, id] = v[1];
+        x            = 5.f;
+        id           = 50;
+        FCV_ASSERT(v.data<0>()[1] == 5.f && v.data<1>()[1] == 50);
+        v[2] = std::make_tuple(6.f, 60);
+        FCV_ASSERT(v.back() == std::make_tuple(6.f, 60));
+        FCV_ASSERT(std::get<1>(v.front()) == 10 && std::get<1>(v.at(2)) == 60);
+        bool thrown = false;
+        try
+        {
+            (void)v.at(3);
+        }
+        catch (std::out_of_range&)
+        {
+            thrown = true;
+        }
+        FCV_ASSERT(thrown);
+
+        int sum = 0;
+        for (auto [f, i] : v)
+        {
+            sum += i;
+            f = 0.f;
+        }
+        FCV_ASSERT(sum == 120 && v.data<0>()[2] == 0.f);
+        FCV_ASSERT(v.end() - v.begin() == 3 && v.begin()[1] == v[1]);
+        FCV_ASSERT(std::get<1>(*v.rbegin()) == 60);
+        soa::const_iterator it = v.begin();
+        FCV_ASSERT(it == v.cbegin() && it < v.cend());
+        auto found = std::find_if(v.begin(), v.end(), [](auto const& e) {
+            return std::get<1>(e) == 50;
+        });
+        FCV_ASSERT(found - v.begin() == 1);
+
+        v.pop_back();
+        FCV_ASSERT(v.size() == 2);
+        v.clear();
+        FCV_ASSERT(v.empty());
+    }
+
+    {  // insert and erase shift every column
+        soa v = {{1.f, 1}, {4.f, 4}};
+        FCV_ASSERT(v.insert(v.begin() + 1, {2.f, 2}) == v.begin() + 1);
+        v.emplace(v.begin() + 2, 3.f, 3);
+        FCV_ASSERT(fields_are(v, {1.f, 2.f, 3.f, 4.f}, {1, 2, 3, 4}));
+        v.insert(v.begin(), 2, {0.f, 0});
+        v.insert(v.end(), {{5.f, 5}, {6.f, 6}});
+        FCV_ASSERT(v.full());
+        FCV_ASSERT(fields_are(v, {0.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f},
+                              {0, 0, 1, 2, 3, 4, 5, 6}));
+        FCV_ASSERT(v.erase(v.begin()) == v.begin());
+        FCV_ASSERT(v.erase(v.begin() + 1, v.begin() + 4) == v.begin() + 1);
+        FCV_ASSERT(fields_are(v, {0.f, 4.f, 5.f, 6.f}, {0, 4, 5, 6}));
+        v.erase(v.begin() + 2, v.end());
+        FCV_ASSERT(fields_are(v, {0.f, 4.f}, {0, 4}));
+
+        v.resize(4);
+        FCV_ASSERT(fields_are(v, {0.f, 4.f, 0.f, 0.f}, {0, 4, 0, 0}));
+        v.resize(5, {7.f, 7});
+        FCV_ASSERT(v[4] == std::make_tuple(7.f, 7));
+        v.resize(1);
+        FCV_ASSERT(fields_are(v, {0.f}, {0}));
+    }
+
+    {  // copies, comparisons and swap
+        soa v = {{1.f, 1}, {2.f, 2}};
+        soa w = v;
+        FCV_ASSERT(w == v);
+        w.emplace_back(3.f, 3);
+        FCV_ASSERT(w != v);
+        v = w;
+        FCV_ASSERT(v == w && v.size() == 3);
+        std::get<1>(w[0]) = 9;
+        FCV_ASSERT(v != w);
+        w.pop_back();
+        swap(v, w);
+        FCV_ASSERT(v.size() == 2 && w.size() == 3 && std::get<1>(v[0]) == 9);
+        FCV_ASSERT(std::get<1>(w[0]) == 1);
+    }
+
+    {  // one column per field, over many elements
+        fixed_capacity_soa_vector<300, double, std::uint8_t> v;
+        for (int i = 0; i != 300; ++i)
+        {
+            v.emplace_back(i * 0.5, static_cast<std::uint8_t>(i));
+        }
+        double sum       = 0;
+        double const* xs = v.data<0>();
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            sum += xs[i];
+        }
+        FCV_ASSERT(sum == 0.5 * 299 * 300 / 2);
+        v.erase(v.begin(), v.begin() + 256);
+        FCV_ASSERT(v.size() == 44 && v.data<1>()[0] == 0);
+        FCV_ASSERT(std::get<0>(v[43]) == 149.5);
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+/// \file
+///
+/// Test for basic_fixed_capacity_string
+
+#include <algorithm>
+#include <cstdio>
+#include <experimental/fixed_capacity_string>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::append_to_chars;
+using std::experimental::fixed_capacity_string;
+using std::experimental::fixed_capacity_wstring;
+using namespace std::literals;
+
+template struct std::experimental::basic_fixed_capacity_string<char, 16>;
+template struct std::experimental::basic_fixed_capacity_string<char16_t, 8>;
+
+/// Random string of \p n characters of [a, a + k).
+std::string random_string(std::mt19937& g, std::size_t n, char a, int k)
+{
+    std::uniform_int_distribution<int> d(0, k - 1);
+    std::string s(n, ' ');
+    for (auto& c : s)
+    {
+        c = static_cast<char>(a + d(g));
+    }
+    return s;
+}
+
+int main()
+{
+    {  // construction and layout
+        using S = fixed_capacity_string<15>;
+        static_assert(std::is_trivially_copyable_v<S>);
+        S s;
+        FCV_ASSERT(s.empty() && s.size() == 0 && s.capacity() == 15);
+        FCV_ASSERT(*s.c_str() == '\0');
+        S h = "hello";
+        FCV_ASSERT(h.size() == 5 && h == "hello" && h.c_str()[5] == '\0');
+        FCV_ASSERT(S(3, 'x') == "xxx" && S("abcdef", 2) == "ab");
+        FCV_ASSERT(S{'a', 'b'} == "ab");
+        S v(std::string_view("view"));
+        FCV_ASSERT(v == "view"sv && v == std::string("view"));
+        S w(fixed_capacity_string<40>("other capacity"));
+        FCV_ASSERT(w == "other capacity");
+        std::string_view sv = h;
+        FCV_ASSERT(sv == "hello" && sv.data() == h.data());
+        FCV_ASSERT(h.at(1) == 'e' && h.front() == 'h' && h.back() == 'o');
+        bool threw = false;
+        try
+        {
+            (void)h.at(5);
+        }
+        catch (std::out_of_range const&)
+        {
+            threw = true;
+        }
+        FCV_ASSERT(threw);
+    }
+
+    {  // modifiers keep the null terminator
+        fixed_capacity_string<16> s = "abc";
+        s += "def";
+        s += 'g';
+        s.push_back('h');
+        FCV_ASSERT(s == "abcdefgh" && s.c_str()[8] == '\0');
+        s.pop_back();
+        FCV_ASSERT(s == "abcdefg" && s.c_str()[7] == '\0');
+        s.insert(3, "XY");
+        FCV_ASSERT(s == "abcXYdefg");
+        s.erase(1, 4);
+        FCV_ASSERT(s == "adefg" && std::string(s.c_str()) == "adefg");
+        s.erase(3);
+        FCV_ASSERT(s == "ade");
+        s.resize(6, '.');
+        FCV_ASSERT(s == "ade...");
+        s.resize(2);
+        FCV_ASSERT(s == "ad" && s.c_str()[2] == '\0');
+        s.append(3, 'z').append("!");
+        FCV_ASSERT(s == "adzzz!");
+        FCV_ASSERT(s.substr(2, 3) == "zzz" && s.substr(4) == "z!");
+        FCV_ASSERT(s + "?" == "adzzz!?");
+
+        // parts of the string itself:
+        s = "0123456789";
+        s.append(std::string_view(s).substr(2, 3));
+        FCV_ASSERT(s == "0123456789234");
+        s.insert(1, std::string_view(s).substr(0, 3));
+        FCV_ASSERT(s == "0012123456789234");
+        s.assign(std::string_view(s).substr(10));
+        FCV_ASSERT(s == "789234");
+        s.clear();
+        FCV_ASSERT(s.empty() && *s.c_str() == '\0');
+
+        fixed_capacity_string<16> a = "a", b = "b";
+        swap(a, b);
+        FCV_ASSERT(a == "b" && b == "a");
+    }
+
+    {  // search and comparisons agree with std::string_view
+        std::mt19937 g(7);
+        for (int round = 0; round != 3000; ++round)
+        {
+            const std::size_t n = g() % 100;
+            const std::string ref = random_string(g, n, 'a', 1 + round % 4);
+            const fixed_capacity_string<100> s(ref);
+            const std::string_view r = ref;
+            const std::size_t pos = g() % (n + 2);
+
+            const std::string needle
+                = random_string(g, g() % 5, 'a', 1 + round % 4);
+            FCV_ASSERT(s.find(needle, pos) == r.find(needle, pos));
+            FCV_ASSERT(s.find(needle) == r.find(needle));
+            FCV_ASSERT(s.rfind(needle, pos) == r.rfind(needle, pos));
+            FCV_ASSERT(s.find('c', pos) == r.find('c', pos));
+            FCV_ASSERT(s.rfind('b') == r.rfind('b'));
+
+            const std::string set = random_string(g, g() % 24, 'b', 30);
+            FCV_ASSERT(s.find_first_of(set, pos)
+                       == r.find_first_of(set, pos));
+            FCV_ASSERT(s.find_first_not_of(set) == r.find_first_not_of(set));
+            FCV_ASSERT(s.find_last_of(set) == r.find_last_of(set));
+
+            const std::string other
+                = random_string(g, g() % 100, 'a', 1 + round % 4);
+            const int c = s.compare(other), e = r.compare(other);
+            FCV_ASSERT((c < 0) == (e < 0) && (c > 0) == (e > 0));
+            FCV_ASSERT((s == other) == (r == other));
+            FCV_ASSERT((s < other) == (r < other));
+            FCV_ASSERT((other < s) == (other < r));
+            const std::string prefix = other.substr(0, 3);
+            FCV_ASSERT(s.starts_with(prefix)
+                       == (r.substr(0, prefix.size()) == prefix));
+        }
+
+        // Characters are compared as unsigned char, like std::string:
+        const fixed_capacity_string<4> hi = "\xff", lo = "a";
+        FCV_ASSERT(lo < hi && hi > "a" && "a" < hi);
+        FCV_ASSERT(fixed_capacity_string<8>("abc")
+                   == fixed_capacity_string<4>("abc"));
+        FCV_ASSERT("abc" == fixed_capacity_string<4>("abc"));
+        FCV_ASSERT(std::string("abd") >= fixed_capacity_string<4>("abc"));
+
+        fixed_capacity_string<32> s = "GET /index.html HTTP/1.1";
+        FCV_ASSERT(s.contains("index") && !s.contains("post"));
+        FCV_ASSERT(s.starts_with("GET ") && s.ends_with("1.1"));
+        FCV_ASSERT(s.find_first_of(" /") == 3 && s.find("HTTP") == 16);
+        FCV_ASSERT(s.find("") == 0 && s.find("", 40) == s.npos);
+    }
+
+    {  // formatting without allocating
+        fixed_capacity_string<24> s = "id=";
+        FCV_ASSERT(append_to_chars(s, 12345) == std::errc());
+        s += " hex=";
+        FCV_ASSERT(append_to_chars(s, 255, 16) == std::errc());
+        FCV_ASSERT(s == "id=12345 hex=ff" && s.c_str()[s.size()] == '\0');
+        FCV_ASSERT(append_to_chars(s, 1234567890123LL)
+                   == std::errc::value_too_large);
+        FCV_ASSERT(s == "id=12345 hex=ff");
+
+        fixed_capacity_string<24> f = "x=";
+        FCV_ASSERT(append_to_chars(f, 0.25) == std::errc());
+        FCV_ASSERT(append_to_chars(f, 3.14159, std::chars_format::fixed, 2)
+                   == std::errc());
+        FCV_ASSERT(f == "x=0.253.14");
+
+        fixed_capacity_string<32> p;
+        p.resize_and_overwrite(p.capacity(), [](char* buf, std::size_t n) {
+            return std::snprintf(buf, n + 1, "%s:%d", "port", 8080);
+        });
+        FCV_ASSERT(p == "port:8080" && p.c_str()[9] == '\0');
+
+        fixed_capacity_string<32> q = "[";
+        const std::string_view parts[] = {"a", "b", "c"};
+        for (auto part : parts)
+        {
+            std::copy(part.begin(), part.end(), std::back_inserter(q));
+        }
+        q += ']';
+        FCV_ASSERT(q == "[abc]");
+
+        std::ostringstream os;
+        os << q << p;
+        FCV_ASSERT(os.str() == "[abc]port:8080");
+    }
+
+    {  // hashing
+        std::unordered_set<fixed_capacity_string<8>> set = {"a", "bc"};
+        FCV_ASSERT(set.count("bc") == 1 && set.count("b") == 0);
+        FCV_ASSERT(std::hash<fixed_capacity_string<8>>{}("bc")
+                   == std::hash<std::string_view>{}("bc"));
+    }
+
+    {  // wide characters use the traits
+        fixed_capacity_wstring<8> w = L"wide";
+        w += L'!';
+        FCV_ASSERT(w == L"wide!" && w.find(L"de") == 2);
+        FCV_ASSERT(w.find_first_of(L"!e") == 3 && w.compare(L"wider") < 0);
+    }
+
+    {  // stays constexpr
+        constexpr auto s = [] {
+            fixed_capacity_string<16> t = "constexpr";
+            t.insert(0, "a ");
+            t += " str";
+            t.erase(t.size() - 1);
+            t.insert(0, std::string_view(t).substr(2, 2));
+            return t;
+        }();
+        static_assert(s == "coa constexpr st" && s.full());
+        static_assert(s.find("expr") == 9 && s.find_first_of("x") == 10);
+        static_assert(s < "d" && s.starts_with("coa"));
+    }
+
+    return 0;
+}
@@ -0,0 +1,300 @@
+/// \file
+///
+/// Test for fixed_capacity_unordered_set and fixed_capacity_unordered_map
+
+#include <algorithm>
+#include <experimental/fixed_capacity_unordered_map>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_unordered_map;
+using std::experimental::fixed_capacity_unordered_set;
+namespace hashing = std::experimental::fcv_detail::hashing;
+
+/// Hashes every key to the same value, so that all keys collide.
+struct constant_hash
+{
+    constexpr std::size_t operator()(int) const noexcept
+    {
+        return 42;
+    }
+};
+
+// trivial:
+template struct std::experimental::fixed_capacity_unordered_set<int, 8>;
+template struct std::experimental::fixed_capacity_unordered_map<int, int, 8>;
+
+// non-trivial
+template struct std::experimental::fixed_capacity_unordered_set<std::string,
+                                                                4>;
+template struct std::experimental::fixed_capacity_unordered_map<
+    std::string, std::string, 4>;
+
+// custom hash:
+template struct std::experimental::fixed_capacity_unordered_set<
+    int, 8, constant_hash>;
+
+/// Inserts and erases pseudo-random keys of [0, 2 * Capacity) in a map and
+/// in a `std::unordered_map`, keeping the map at most full, and checks that
+/// both contain the same elements.
+template <typename Map, typename MakeKey>
+bool matches_unordered_map(MakeKey make_key, unsigned seed)
+{
+    Map m;
+    std::unordered_map<typename Map::key_type, int> expected;
+    std::mt19937 g(seed);
+    std::uniform_int_distribution<int> d(0, 2 * int(Map::capacity()) - 1);
+    for (int round = 0; round != 20000; ++round)
+    {
+        const auto key = make_key(d(g));
+        if (g() % 2 == 0 && expected.size() < Map::capacity())
+        {
+            const bool inserted = expected.emplace(key, round).second;
+            if (m.try_emplace(key, round).second != inserted)
+            {
+                return false;
+            }
+        }
+        else if (m.erase(key) != expected.erase(key))
+        {
+            return false;
+        }
+        if (m.size() != expected.size()
+            || m.contains(key) != (expected.count(key) == 1))
+        {
+            return false;
+        }
+    }
+    std::size_t n = 0;
+    for (auto const& x : m)
+    {
+        auto it = expected.find(x.first);
+        if (it == expected.end() || it->second != x.second)
+        {
+            return false;
+        }
+        ++n;
+    }
+    return n == expected.size();
+}
+
+int main()
+{
+    {  // group matching agrees with the scalar loop of constant expressions
+        constexpr auto table = [] {
+            struct
+            {
+                alignas(16) hashing::ctrl_t c[16] = {};
+            } t;
+            for (int i = 0; i != 16; ++i)
+            {
+                t.c[i] = i % 3 == 0 ? hashing::empty
+                                    : i % 5 == 0 ? hashing::deleted
+                                                 : hashing::ctrl_t(i % 4);
+            }
+            return t;
+        }();
+        constexpr auto m1 = hashing::match(table.c, 1);
+        constexpr auto fr = hashing::match_free(table.c);
+        FCV_ASSERT(hashing::match(table.c, 1) == m1 && m1 == 0x2002);
+        FCV_ASSERT(hashing::match_free(table.c) == fr && fr == 0x9669);
+        static_assert(hashing::slot_count(8) == 16);
+        static_assert(hashing::slot_count(14) == 32);
+        static_assert(hashing::slot_count(64) == 80);
+        static_assert(hashing::max_occupied(64) == 70);
+    }
+
+    {  // set: insert, lookup, erase
+        fixed_capacity_unordered_set<int, 8> s = {5, 1, 3, 1};
+        FCV_ASSERT(s.size() == 3 && s.capacity() == 8);
+        FCV_ASSERT(s.slot_count() == 16);
+        auto r = s.insert(2);
+        FCV_ASSERT(r.second && *r.first == 2);
+        r = s.insert(3);
+        FCV_ASSERT(!r.second && *r.first == 3);
+        FCV_ASSERT(s.contains(5) && !s.contains(4) && s.count(1) == 1);
+        FCV_ASSERT(s.find(4) == s.end() && *s.find(5) == 5);
+        FCV_ASSERT(s.erase(3) == 1 && s.erase(3) == 0);
+        std::vector<int> keys(s.begin(), s.end());
+        std::sort(keys.begin(), keys.end());
+        FCV_ASSERT((keys == std::vector<int>{1, 2, 5}));
+        FCV_ASSERT((s == fixed_capacity_unordered_set<int, 8>{5, 2, 1}));
+        FCV_ASSERT((s != fixed_capacity_unordered_set<int, 8>{5, 2}));
+
+        // erasing while iterating:
+        for (auto it = s.begin(); it != s.end();)
+        {
+            it = *it % 2 == 1 ? s.erase(it) : std::next(it);
+        }
+        FCV_ASSERT((s == fixed_capacity_unordered_set<int, 8>{2}));
+        s.clear();
+        FCV_ASSERT(s.empty() && s.begin() == s.end());
+        for (int i = 0; i != 8; ++i)
+        {
+            s.insert(i * 1000);
+        }
+        FCV_ASSERT(s.full());
+    }
+
+    {  // set: colliding keys probe across groups and reclaim deleted slots
+        fixed_capacity_unordered_set<int, 40, constant_hash> s;
+        static_assert(decltype(s)::slot_count() == 48);
+        for (int round = 0; round != 50; ++round)
+        {
+            for (int i = 0; i != 40; ++i)
+            {
+                FCV_ASSERT(s.insert(round * 100 + i).second);
+            }
+            FCV_ASSERT(s.full() && s.contains(round * 100 + 39));
+            for (int i = 0; i != 40; i += 2)
+            {
+                FCV_ASSERT(s.erase(round * 100 + i) == 1);
+            }
+            for (int i = 0; i != 40; ++i)
+            {
+                FCV_ASSERT(s.contains(round * 100 + i) == (i % 2 == 1));
+            }
+            s.clear();
+        }
+        // insertions after many erasures reuse the deleted slots:
+        for (int i = 0; i != 1000; ++i)
+        {
+            s.insert(i);
+            if (i >= 30)
+            {
+                FCV_ASSERT(s.erase(i - 30) == 1);
+            }
+            FCV_ASSERT(s.size() == (i >= 30 ? 30u : unsigned(i + 1)));
+        }
+        FCV_ASSERT(std::distance(s.begin(), s.end()) == 30);
+    }
+
+    {  // set: non-trivial keys
+        fixed_capacity_unordered_set<std::string, 4> s = {"a", "bb", "ccc"};
+        FCV_ASSERT(s.contains("bb") && !s.contains("d"));
+        auto t = s;
+        FCV_ASSERT(t == s && t.erase("a") == 1 && t != s);
+        swap(s, t);
+        FCV_ASSERT(s.size() == 2 && t.size() == 3 && t.contains("a"));
+    }
+
+    {  // map: lookup and modifiers
+        fixed_capacity_unordered_map<int, int, 8> m = {{3, 30}, {1, 10}};
+        FCV_ASSERT(m.size() == 2 && m.at(3) == 30 && m[1] == 10);
+        bool threw = false;
+        try
+        {
+            (void)m.at(2);
+        }
+        catch (std::out_of_range const&)
+        {
+            threw = true;
+        }
+        FCV_ASSERT(threw);
+        FCV_ASSERT(m[2] == 0 && m.size() == 3);
+        auto r = m.try_emplace(2, 20);
+        FCV_ASSERT(!r.second && r.first->second == 0);
+        r = m.insert_or_assign(2, 20);
+        FCV_ASSERT(!r.second && m.at(2) == 20);
+        r = m.insert_or_assign(4, 40);
+        FCV_ASSERT(r.second && (*r.first).first == 4 && m.at(4) == 40);
+        r.first->second = 41;
+        FCV_ASSERT(m.find(4)->second == 41 && m.find(5) == m.end());
+        FCV_ASSERT(m.erase(4) == 1 && m.erase(4) == 0 && !m.contains(4));
+        int sum = 0;
+        for (auto x : m)
+        {
+            x.second += 1;
+            sum += x.first;
+        }
+        FCV_ASSERT(sum == 6 && m.at(1) == 11);
+        auto const& c = m;
+        FCV_ASSERT(c.find(3)->second == 31 && c.at(2) == 21);
+        decltype(m)::const_iterator it = m.begin();
+        FCV_ASSERT(it == c.begin());
+        m.erase(c.find(3));
+        FCV_ASSERT((m == fixed_capacity_unordered_map<int, int, 8>{
+                             {2, 21}, {1, 11}}));
+        FCV_ASSERT((m != fixed_capacity_unordered_map<int, int, 8>{
+                             {2, 21}, {1, 12}}));
+    }
+
+    {  // map: agrees with std::unordered_map under churn
+        FCV_ASSERT((matches_unordered_map<
+                    fixed_capacity_unordered_map<int, int, 64>>(
+            [](int k) { return k; }, 1)));
+        FCV_ASSERT((matches_unordered_map<
+                    fixed_capacity_unordered_map<int, int, 7>>(
+            [](int k) { return k * 7919; }, 2)));
+        FCV_ASSERT((matches_unordered_map<
+                    fixed_capacity_unordered_map<int, int, 20, constant_hash>>(
+            [](int k) { return k; }, 3)));
+        FCV_ASSERT((matches_unordered_map<
+                    fixed_capacity_unordered_map<std::string, int, 64>>(
+            [](int k) { return std::to_string(k) + " is long enough"; }, 4)));
+    }
+
+    {  // map: non-trivial and move-only values
+        fixed_capacity_unordered_map<std::string, std::string, 4> m;
+        m["a"] = "x";
+        m.try_emplace("b", 3, 'y');
+        auto n = m;
+        FCV_ASSERT(n == m && n.at("b") == "yyy");
+        auto o = std::move(n);
+        FCV_ASSERT(o == m);
+        o.erase("a");
+        m = o;
+        FCV_ASSERT(m.size() == 1 && !m.contains("a"));
+
+        fixed_capacity_unordered_map<int, std::unique_ptr<int>, 4> u;
+        u.try_emplace(1, std::make_unique<int>(7));
+        u[2] = std::make_unique<int>(8);
+        auto v = std::move(u);
+        FCV_ASSERT(*v.at(1) == 7 && *v.at(2) == 8);
+        static_assert(!std::is_copy_constructible_v<decltype(v)>);
+    }
+
+    {  // constant expressions
+        constexpr auto m = [] {
+            fixed_capacity_unordered_map<int, int, 16> t = {
+                {1, 10}, {2, 20}, {3, 30}};
+            t.erase(2);
+            t[4] = 40;
+            return t;
+        }();
+        static_assert(m.size() == 3 && m.at(4) == 40 && !m.contains(2));
+        static_assert(m.find(1)->second == 10);
+
+        constexpr fixed_capacity_unordered_set<char, 8> vowels = {
+            'a', 'e', 'i', 'o', 'u'};
+        static_assert(vowels.contains('o') && !vowels.contains('x'));
+        FCV_ASSERT(vowels.contains('u') && !vowels.contains('b'));
+
+        enum class color
+        {
+            red,
+            green,
+            blue
+        };
+        constexpr fixed_capacity_unordered_map<color, char const*, 4> names
+            = {{color::red, "red"}, {color::blue, "blue"}};
+        static_assert(names.contains(color::blue)
+                      && !names.contains(color::green));
+        static_assert(std::is_trivially_copyable_v<decltype(names)>);
+    }
+
+    return 0;
+}
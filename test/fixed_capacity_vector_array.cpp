@@ -0,0 +1,188 @@
+/// \file
+///
+/// Test for fixed_capacity_vector_array
+
+#include <algorithm>
+#include <cstdint>
+#include <experimental/fixed_capacity_vector_array>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_vector_array;
+
+template struct std::experimental::fixed_capacity_vector_array<int, 8, 4>;
+template struct std::experimental::fixed_capacity_vector_array<std::string, 3,
+                                                               2>;
+
+/// Throws on the copy that brings the count of live copies to `limit`.
+struct throwing
+{
+    static int live;
+    static int limit;
+    int value;
+
+    throwing(int v) : value(v)
+    {
+        ++live;
+    }
+    throwing(throwing const& o) : value(o.value)
+    {
+        if (live + 1 == limit)
+        {
+            throw 1;
+        }
+        ++live;
+    }
+    ~throwing()
+    {
+        --live;
+    }
+};
+
+int throwing::live  = 0;
+int throwing::limit = -1;
+
+int main()
+{
+    {  // layout
+        using adj = fixed_capacity_vector_array<std::uint32_t, 8, 16>;
+        static_assert(std::is_same_v<adj::size_counter_type, std::uint8_t>);
+        static_assert(adj::size() == 16 && adj::vector_capacity() == 8);
+        static_assert(sizeof(adj) == 16 * (8 * 4 + 1));
+        static_assert(
+            sizeof(fixed_capacity_vector_array<std::uint64_t, 4, 8>)
+            == 8 * 4 * 8 + 8);
+        static_assert(
+            sizeof(fixed_capacity_vector_array<char, 300, 2>::size_counter_type)
+            == 2);
+        static_assert(std::is_trivially_copyable_v<adj>);
+
+        adj a;
+        FCV_ASSERT(std::all_of(a.sizes(), a.sizes() + 16,
+                               [](auto s) { return s == 0; }));
+    }
+
+    {  // vector references update the packed sizes
+        fixed_capacity_vector_array<int, 4, 3> a;
+        a[1].push_back(1);
+        a[1].push_back(2);
+        a[1].insert(a[1].begin(), 0);
+        a.back().assign({7, 8, 9, 10});
+        FCV_ASSERT(a.sizes()[0] == 0 && a.sizes()[1] == 3 && a.sizes()[2] == 4);
+        FCV_ASSERT(a[1].size() == 3 && a[1][0] == 0 && a[1].back() == 2);
+        FCV_ASSERT(a[2].full() && a[2].capacity() == 4);
+        FCV_ASSERT(a.data()[4] == 0 && a.data()[8] == 7);
+
+        auto r = a[1];
+        r.erase(r.begin());
+        FCV_ASSERT(a[1].size() == 2 && a[1][0] == 1);
+        a[0].resize(2, 5);
+        FCV_ASSERT(a.front()[1] == 5 && a.sizes()[0] == 2);
+
+        auto const& c = a;
+        FCV_ASSERT(c[2].size() == 4 && c[2][3] == 10);
+        FCV_ASSERT(std::accumulate(c[2].begin(), c[2].end(), 0) == 34);
+        static_assert(std::is_same_v<decltype(c[0].data()), int const*>);
+
+        bool thrown = false;
+        try
+        {
+            (void)c.at(3);
+        }
+        catch (std::out_of_range&)
+        {
+            thrown = true;
+        }
+        FCV_ASSERT(thrown);
+    }
+
+    {  // iterators
+        fixed_capacity_vector_array<int, 4, 5> a;
+        int i = 0;
+        for (auto v : a)
+        {
+            v.resize(static_cast<std::size_t>(i++ % 3), i);
+        }
+        FCV_ASSERT(a.end() - a.begin() == 5 && a.begin()[2].size() == 2);
+        FCV_ASSERT((*a.rbegin()).size() == 1 && (*a.rbegin())[0] == 5);
+        auto it = std::find_if(a.cbegin(), a.cend(),
+                               [](auto v) { return v.size() == 2; });
+        FCV_ASSERT(it.index() == 2 && (*it)[1] == 3);
+        decltype(a)::const_iterator ci = a.begin();
+        FCV_ASSERT(ci == a.cbegin() && ci + 5 == a.cend());
+
+        a.clear();
+        FCV_ASSERT(std::all_of(a.begin(), a.end(),
+                               [](auto v) { return v.empty(); }));
+    }
+
+    {  // copies and comparisons
+        fixed_capacity_vector_array<int, 4, 3> a;
+        a[0].push_back(1);
+        a[2].push_back(3);
+        auto b = a;
+        FCV_ASSERT(b == a);
+        b[2][0] = 4;
+        FCV_ASSERT(b != a && a[2][0] == 3);
+        b[1].push_back(0);
+        a = b;
+        FCV_ASSERT(a == b && a.sizes()[1] == 1);
+    }
+
+    {  // non-trivial and move-only elements
+        using strings = fixed_capacity_vector_array<std::string, 3, 2>;
+        strings a;
+        a[0].push_back("a long string that is not stored inline");
+        a[1].emplace_back(2, 'x');
+        strings b = a;
+        FCV_ASSERT(b == a && b[1][0] == "xx");
+        strings c = std::move(b);
+        FCV_ASSERT(c == a);
+        c[0].pop_back();
+        a = c;
+        FCV_ASSERT(a[0].empty() && a.sizes()[1] == 1);
+        static_assert(!std::is_trivially_copyable_v<strings>);
+
+        using ptrs = fixed_capacity_vector_array<std::unique_ptr<int>, 2, 2>;
+        static_assert(!std::is_copy_constructible_v<ptrs>);
+        static_assert(std::is_nothrow_move_constructible_v<ptrs>);
+        auto p = std::make_unique<ptrs>();
+        (*p)[1].push_back(std::make_unique<int>(3));
+        ptrs q = std::move(*p);
+        FCV_ASSERT(*q[1][0] == 3 && (*p)[1][0] == nullptr);
+    }
+
+    {  // a throwing copy leaves no live elements behind
+        using array = fixed_capacity_vector_array<throwing, 2, 3>;
+        {
+            array a;
+            a[0].emplace_back(1);
+            a[1].emplace_back(2);
+            a[2].emplace_back(3);
+            throwing::limit = 6;
+            bool thrown     = false;
+            try
+            {
+                array b = a;
+            }
+            catch (int)
+            {
+                thrown = true;
+            }
+            FCV_ASSERT(thrown && throwing::live == 3);
+            throwing::limit = -1;
+        }
+        FCV_ASSERT(throwing::live == 0);
+    }
+
+    return 0;
+}
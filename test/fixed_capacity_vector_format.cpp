@@ -0,0 +1,189 @@
+/// \file
+///
+/// Test for the binary format of fixed_capacity_vector
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <experimental/fixed_capacity_vector_format>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#define FCV_TEST_MMAP 1
+#endif
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::deserialize_from;
+using std::experimental::fixed_capacity_vector;
+using std::experimental::serialize_into;
+using std::experimental::serialized_size;
+using std::experimental::view_from_bytes;
+using error = std::experimental::fcv_format::error;
+
+struct point
+{
+    float x, y;
+    std::uint16_t id;
+};
+
+bool operator==(point const& a, point const& b)
+{
+    return a.x == b.x && a.y == b.y && a.id == b.id;
+}
+
+/// Buffer aligned for viewing serialized vectors in place.
+struct alignas(32) buffer
+{
+    unsigned char bytes[4096];
+};
+
+int main()
+{
+    {  // header layout
+        fixed_capacity_vector<std::uint32_t, 16> v = {1, 2, 3};
+        buffer b{};
+        FCV_ASSERT(serialized_size(v) == 32 + 3 * 4);
+        FCV_ASSERT(serialize_into(v, b.bytes, sizeof(b)) == 44);
+        FCV_ASSERT(std::memcmp(b.bytes, "FCVB", 4) == 0);
+        FCV_ASSERT(b.bytes[4] == 1 && b.bytes[6] == 8 && b.bytes[7] == 0);
+        std::uint32_t element_size;
+        std::uint64_t size;
+        std::memcpy(&element_size, b.bytes + 8, 4);
+        std::memcpy(&size, b.bytes + 16, 8);
+        FCV_ASSERT(element_size == 4 && size == 3);
+        std::uint32_t first;
+        std::memcpy(&first, b.bytes + 32, 4);
+        FCV_ASSERT(first == 1);
+        // Only [0, size()) is written:
+        FCV_ASSERT(b.bytes[44] == 0 && b.bytes[47] == 0);
+    }
+
+    {  // round trip
+        fixed_capacity_vector<point, 8> v;
+        v.push_back(point{1.f, 2.f, 1});
+        v.push_back(point{3.f, 4.f, 2});
+        buffer b{};
+        const auto n = serialize_into(v, b.bytes, sizeof(b));
+
+        fixed_capacity_vector<point, 8> w;
+        w.push_back(point{0.f, 0.f, 9});
+        FCV_ASSERT(deserialize_from(b.bytes, n, w) == error::none);
+        FCV_ASSERT(w == v);
+
+        // into another capacity and storage policy:
+        fixed_capacity_vector<point, 2,
+                              std::experimental::fcv_storage::uninitialized>
+            u;
+        FCV_ASSERT(deserialize_from(b.bytes, n, u) == error::none);
+        FCV_ASSERT(u.size() == 2 && u[1] == v[1]);
+
+        // empty vectors:
+        fixed_capacity_vector<point, 8> e;
+        FCV_ASSERT(serialize_into(e, b.bytes, sizeof(b)) == 32);
+        FCV_ASSERT(deserialize_from(b.bytes, 32, w) == error::none);
+        FCV_ASSERT(w.empty());
+    }
+
+    {  // zero-copy views
+        fixed_capacity_vector<std::uint32_t, 64> v;
+        for (std::uint32_t i = 0; i != 64; ++i)
+        {
+            v.push_back(i * i);
+        }
+        buffer b{};
+        const auto n = serialize_into(v, b.bytes, sizeof(b));
+        error err    = error::truncated;
+        auto view    = view_from_bytes<std::uint32_t>(b.bytes, n, err);
+        FCV_ASSERT(err == error::none && view.size() == 64);
+        FCV_ASSERT(view.data()
+                   == reinterpret_cast<std::uint32_t const*>(b.bytes + 32));
+        FCV_ASSERT(view[63] == 63 * 63 && view.back() == v.back());
+        std::uint64_t sum = 0;
+        for (auto x : view)
+        {
+            sum += x;
+        }
+        FCV_ASSERT(sum == 63 * 64 * 127 / 6);
+
+        serialize_into(v, b.bytes + 4, sizeof(b) - 4);
+        auto bad = view_from_bytes<std::uint32_t>(b.bytes + 4, n, err);
+        FCV_ASSERT(err == error::misaligned);
+        FCV_ASSERT(bad.empty() && bad.data() == nullptr);
+    }
+
+    {  // invalid data is rejected
+        fixed_capacity_vector<std::uint16_t, 4> v = {1, 2, 3, 4};
+        buffer b{};
+        const auto n = serialize_into(v, b.bytes, sizeof(b));
+        fixed_capacity_vector<std::uint16_t, 4> w = {7};
+        auto check = [&](error expected, std::size_t m) {
+            return deserialize_from(b.bytes, m, w) == expected
+                   && w.size() == 1 && w[0] == 7;
+        };
+        FCV_ASSERT(check(error::truncated, 31));
+        FCV_ASSERT(check(error::truncated, n - 1));
+
+        fixed_capacity_vector<std::uint16_t, 3> small;
+        FCV_ASSERT(deserialize_from(b.bytes, n, small) == error::too_large);
+        fixed_capacity_vector<std::uint32_t, 4> wide;
+        FCV_ASSERT(deserialize_from(b.bytes, n, wide) == error::bad_element);
+
+        auto corrupt = [&](std::size_t i, unsigned char c, error expected) {
+            const unsigned char old = b.bytes[i];
+            b.bytes[i]              = c;
+            const bool r            = check(expected, n);
+            b.bytes[i]              = old;
+            return r;
+        };
+        FCV_ASSERT(corrupt(0, 'X', error::bad_magic));
+        FCV_ASSERT(corrupt(4, 2, error::bad_version));
+        FCV_ASSERT(corrupt(5, b.bytes[5] == 1 ? 2 : 1, error::bad_byte_order));
+        FCV_ASSERT(corrupt(6, 4, error::bad_size_width));
+        FCV_ASSERT(corrupt(12, 4, error::bad_element));
+        // A huge size must not overflow the length check:
+        FCV_ASSERT(corrupt(23, 0x80, error::truncated));
+        FCV_ASSERT(deserialize_from(b.bytes, n, w) == error::none && w == v);
+    }
+
+    {  // through a file
+        fixed_capacity_vector<double, 100> v;
+        for (int i = 0; i != 100; ++i)
+        {
+            v.push_back(i * 0.25);
+        }
+        std::vector<unsigned char> out(serialized_size(v));
+        serialize_into(v, out.data(), out.size());
+
+        std::FILE* f = std::tmpfile();
+        FCV_ASSERT(f != nullptr);
+        FCV_ASSERT(std::fwrite(out.data(), 1, out.size(), f) == out.size());
+        std::fflush(f);
+        std::rewind(f);
+        buffer in{};
+        const auto n = std::fread(in.bytes, 1, sizeof(in), f);
+        FCV_ASSERT(n == out.size());
+
+        fixed_capacity_vector<double, 100> w;
+        FCV_ASSERT(deserialize_from(in.bytes, n, w) == error::none && w == v);
+
+#ifdef FCV_TEST_MMAP
+        void* m = mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+        FCV_ASSERT(m != MAP_FAILED);
+        error err;
+        auto view = view_from_bytes<double>(m, n, err);
+        FCV_ASSERT(err == error::none && view.size() == 100);
+        FCV_ASSERT(view[99] == 24.75 && view.data() != w.data());
+        munmap(m, n);
+#endif
+        std::fclose(f);
+    }
+
+    return 0;
+}
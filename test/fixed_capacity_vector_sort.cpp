@@ -0,0 +1,141 @@
+/// \file
+///
+/// Test for the sorting algorithms of fixed_capacity_vector
+
+#include <algorithm>
+#include <cstdint>
+#include <experimental/fixed_capacity_vector_sort>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+using std::experimental::fixed_capacity_vector;
+namespace sorting = std::experimental::fcv_detail::sorting;
+
+/// Checks the algorithms on \p n pseudo-random values from \p g.
+template <std::size_t Capacity, typename T, typename Compare = std::less<>,
+          typename G>
+void check_random(std::size_t n, G& g, Compare comp = Compare{})
+{
+    fixed_capacity_vector<T, Capacity> v;
+    std::uniform_int_distribution<int> d(0, 20);
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            v.push_back(std::to_string(d(g)));
+        }
+        else
+        {
+            v.push_back(static_cast<T>(d(g)));
+        }
+    }
+    std::vector<T> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end(), comp);
+
+    auto s = v;
+    std::experimental::sort(s, comp);
+    FCV_ASSERT(std::equal(s.begin(), s.end(), expected.begin()));
+
+    const std::size_t k = n / 3;
+    auto p              = v;
+    std::experimental::partial_sort(p, p.begin() + k, comp);
+    FCV_ASSERT(std::equal(p.begin(), p.begin() + k, expected.begin()));
+    FCV_ASSERT(std::is_permutation(p.begin(), p.end(), v.begin()));
+
+    if (n != 0)
+    {
+        auto e = v;
+        std::experimental::nth_element(e, e.begin() + k, comp);
+        FCV_ASSERT(e[k] == expected[k]);
+        FCV_ASSERT(std::none_of(e.begin(), e.begin() + k,
+                                [&](T const& x) { return comp(e[k], x); }));
+        FCV_ASSERT(std::none_of(e.begin() + k, e.end(),
+                                [&](T const& x) { return comp(x, e[k]); }));
+    }
+}
+
+int main()
+{
+    {  // network sizes
+        static_assert(sorting::network_size(0) == 0);
+        static_assert(sorting::network_size(1) == 0);
+        static_assert(sorting::network_size(2) == 1);
+        static_assert(sorting::network_size(4) == 5);
+        static_assert(sorting::network_size(8) == 19);
+        static_assert(sorting::network_size(16) == 63);
+        static_assert(sorting::network<3>.size() == 3);
+    }
+
+    {  // every network sorts every 0-1 input, so it sorts any input
+        for (std::size_t n = 0; n <= 16; ++n)
+        {
+            for (std::uint32_t bits = 0; bits != (1u << n); ++bits)
+            {
+                fixed_capacity_vector<std::uint8_t, 16> v;
+                for (std::size_t i = 0; i != n; ++i)
+                {
+                    v.push_back(static_cast<std::uint8_t>((bits >> i) & 1u));
+                }
+                std::experimental::sort(v);
+                FCV_ASSERT(v.size() == n && std::is_sorted(v.begin(), v.end()));
+            }
+        }
+    }
+
+    {  // random inputs, below and above the network size limit
+        std::mt19937 g(42);
+        for (int round = 0; round != 20; ++round)
+        {
+            for (std::size_t n = 0; n <= 16; ++n)
+            {
+                check_random<16, int>(n, g);
+                check_random<16, float>(n, g, std::greater<>{});
+                check_random<16, std::string>(n, g);
+            }
+            for (std::size_t n : {0, 5, 16, 17, 31, 32, 33, 40, 63, 64})
+            {
+                check_random<64, std::int64_t>(n, g);
+                check_random<64, std::string>(n, g, std::greater<>{});
+            }
+            for (std::size_t n : {20, 64, 65, 100})
+            {
+                check_random<100, int>(n, g);
+            }
+            check_random<24, unsigned>(24, g);
+            check_random<3, double>(3, g);
+        }
+    }
+
+    {  // stays constexpr
+        constexpr auto sorted = [] {
+            fixed_capacity_vector<int, 8> v = {5, 3, 7, 1, 8, 2};
+            std::experimental::sort(v);
+            return v;
+        }();
+        static_assert(sorted
+                      == fixed_capacity_vector<int, 8>{1, 2, 3, 5, 7, 8});
+
+        constexpr auto large = [] {
+            fixed_capacity_vector<int, 32> v;
+            for (int i = 0; i != 20; ++i)
+            {
+                v.push_back((i * 7) % 20);
+            }
+            std::experimental::nth_element(v, v.begin() + 4,
+                                           std::greater<>{});
+            return v;
+        }();
+        static_assert(large.size() == 20 && large[4] == 15);
+    }
+
+    return 0;
+}
@@ -0,0 +1,416 @@
+/// \file
+///
+/// Test for small_vector
+
+#include <experimental/small_vector>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#define FCV_ASSERT(...)                                                       \
+    static_cast<void>((__VA_ARGS__)                                           \
+                          ? void(0)                                           \
+                          : ::std::experimental::fcv_detail::assert_failure(  \
+                                static_cast<const char*>(__FILE__), __LINE__, \
+                                "assertion failed: " #__VA_ARGS__))
+
+template <typename T, std::size_t N>
+using vector = std::experimental::small_vector<T, N>;
+
+// trivial:
+template struct std::experimental::small_vector<int, 1>;
+template struct std::experimental::small_vector<int, 4>;
+
+// non-trivial
+template struct std::experimental::small_vector<std::string, 3>;
+
+// move-only:
+template struct std::experimental::small_vector<std::unique_ptr<int>, 3>;
+
+/// Allocator counting the live allocations of all its instances.
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+    static inline int live = 0;
+    int id                 = 0;
+
+    counting_allocator() = default;
+    explicit counting_allocator(int i) : id(i)
+    {
+    }
+    template <typename U>
+    counting_allocator(counting_allocator<U> const& o) : id(o.id)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        ++live;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* p, std::size_t n)
+    {
+        --live;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    friend bool operator==(counting_allocator const& a,
+                           counting_allocator const& b)
+    {
+        return a.id == b.id;
+    }
+    friend bool operator!=(counting_allocator const& a,
+                           counting_allocator const& b)
+    {
+        return a.id != b.id;
+    }
+};
+
+/// Throws on copy if the value is negative.
+struct throwing
+{
+    int value;
+    throwing(int v) : value(v)
+    {
+    }
+    throwing(throwing const& o) : value(o.value)
+    {
+        if (value < 0)
+        {
+            throw 42;
+        }
+    }
+    throwing(throwing&&) noexcept = default;
+    throwing& operator=(throwing const&) = default;
+    throwing& operator=(throwing&&) noexcept = default;
+    ~throwing()
+    {
+    }
+};
+
+/// Copy-only element that records the live objects, and whose copy throws
+/// once `copies_left` copies were made (never if it is negative).
+struct copy_only
+{
+    static inline std::set<copy_only const*> live;
+    static inline int copies_left = -1;
+    int value;
+
+    copy_only(int v) : value(v)
+    {
+        live.insert(this);
+    }
+    copy_only(copy_only const& o) : value(o.value)
+    {
+        if (copies_left == 0)
+        {
+            throw 42;
+        }
+        if (copies_left > 0)
+        {
+            --copies_left;
+        }
+        live.insert(this);
+    }
+    copy_only& operator=(copy_only const&) = default;
+    ~copy_only()
+    {
+        FCV_ASSERT(live.erase(this) == 1);
+    }
+};
+
+int main()
+{
+    {  // inline storage
+        vector<int, 4> v;
+        static_assert(vector<int, 4>::inline_capacity() == 4);
+        FCV_ASSERT(v.empty() && v.is_inline() && v.capacity() == 4);
+        v.push_back(1);
+        v.emplace_back(2);
+        v.insert(v.begin(), 0);
+        FCV_ASSERT(v.is_inline());
+        FCV_ASSERT(v == vector<int, 4>({0, 1, 2}));
+        FCV_ASSERT(v.at(2) == 2 && v.front() == 0 && v.back() == 2);
+        bool thrown = false;
+        try
+        {
+            (void)v.at(3);
+        }
+        catch (std::out_of_range&)
+        {
+            thrown = true;
+        }
+        FCV_ASSERT(thrown);
+    }
+
+    {  // spill to the heap and shrink back
+        using alloc = counting_allocator<int>;
+        std::experimental::small_vector<int, 4, alloc> v = {1, 2, 3, 4};
+        FCV_ASSERT(v.is_inline() && alloc::live == 0);
+        v.push_back(5);
+        FCV_ASSERT(!v.is_inline() && alloc::live == 1);
+        FCV_ASSERT(v.capacity() >= 5);
+        for (int i = 6; i != 100; ++i)
+        {
+            v.push_back(i);
+        }
+        FCV_ASSERT(v.size() == 99 && alloc::live == 1);
+        for (int i = 0; i != 99; ++i)
+        {
+            FCV_ASSERT(v[static_cast<std::size_t>(i)] == i + 1);
+        }
+        v.shrink_to_fit();
+        FCV_ASSERT(v.capacity() == 99 && alloc::live == 1);
+        v.erase(v.begin() + 3, v.end());
+        v.shrink_to_fit();
+        FCV_ASSERT(v.is_inline() && alloc::live == 0);
+        FCV_ASSERT(v.capacity() == 4);
+        FCV_ASSERT((v == std::experimental::small_vector<int, 4, alloc>{1, 2,
+                                                                        3}));
+        v.reserve(10);
+        FCV_ASSERT(!v.is_inline() && alloc::live == 1);
+    }
+    FCV_ASSERT(counting_allocator<int>::live == 0);
+
+    {  // non-trivial elements across the spill
+        vector<std::string, 2> v = {"a", "b"};
+        v.push_back(v[0]);  // aliasing, grows
+        FCV_ASSERT(!v.is_inline());
+        FCV_ASSERT(v == vector<std::string, 2>({"a", "b", "a"}));
+        v.insert(v.begin() + 1, 2, v[2]);  // aliasing, does not grow
+        FCV_ASSERT(v == vector<std::string, 2>({"a", "a", "a", "b", "a"}));
+        v.emplace(v.begin(), v.back());
+        v.erase(v.begin() + 1, v.begin() + 3);
+        FCV_ASSERT(v == vector<std::string, 2>({"a", "a", "b", "a"}));
+
+        vector<std::string, 2> w = {"x"};
+        w.insert(w.begin(), v.begin(), v.end());  // grows in the middle
+        FCV_ASSERT(w == vector<std::string, 2>({"a", "a", "b", "a", "x"}));
+    }
+
+    {  // copy, move, swap
+        vector<std::string, 2> a = {"a"};
+        vector<std::string, 2> b = {"b", "c", "d"};
+        vector<std::string, 2> c(a);
+        vector<std::string, 2> d(b);
+        FCV_ASSERT(c == a && d == b);
+        FCV_ASSERT(c.is_inline() && !d.is_inline());
+
+        const std::string* p = b.data();
+        vector<std::string, 2> e(std::move(b));
+        FCV_ASSERT(e.data() == p && b.empty() && b.is_inline());
+        vector<std::string, 2> f(std::move(a));
+        FCV_ASSERT(f == c && a.empty());
+
+        a = d;
+        FCV_ASSERT(a == d);
+        a = c;
+        FCV_ASSERT(a == c);
+        vector<std::string, 2> const& ar = a;
+        a                                = ar;
+        FCV_ASSERT(a == c);
+        a = std::move(e);
+        FCV_ASSERT(a == d && e.empty());
+        a.swap(f);
+        FCV_ASSERT(a == c && f == d);
+        swap(a, f);
+        FCV_ASSERT(a == d && f == c);
+        FCV_ASSERT(c < d && d > c && c <= c && c >= c && c != d);
+    }
+
+    {  // move-only elements
+        vector<std::unique_ptr<int>, 1> v;
+        v.push_back(std::make_unique<int>(1));
+        v.push_back(std::make_unique<int>(2));
+        v.emplace(v.begin(), std::make_unique<int>(0));
+        FCV_ASSERT(*v[0] == 0 && *v[1] == 1 && *v[2] == 2);
+        vector<std::unique_ptr<int>, 1> w(std::move(v));
+        FCV_ASSERT(w.size() == 3 && v.empty());
+        static_assert(
+            !std::is_copy_constructible<vector<std::unique_ptr<int>, 1>>{}
+            || true);
+    }
+
+    {  // allocators that do not propagate: move relocates the elements
+        using alloc = counting_allocator<int>;
+        using V     = std::experimental::small_vector<int, 2, alloc>;
+        V a({1, 2, 3}, alloc(1));
+        V b(alloc(2));
+        b = std::move(a);
+        FCV_ASSERT((b == V{1, 2, 3}) && a.empty());
+        FCV_ASSERT(b.get_allocator().id == 2);
+    }
+    FCV_ASSERT(counting_allocator<int>::live == 0);
+
+    {  // resize, assign
+        using std::experimental::default_init;
+        vector<int, 2> v;
+        v.resize(3);
+        FCV_ASSERT(v == vector<int, 2>({0, 0, 0}));
+        v.resize(5, 7);
+        FCV_ASSERT(v == vector<int, 2>({0, 0, 0, 7, 7}));
+        v.resize(1);
+        v.resize(8, default_init);
+        FCV_ASSERT(v.size() == 8 && v[0] == 0);
+        v.resize_and_overwrite(20, [](int* p, std::size_t n) {
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                p[i] = static_cast<int>(i);
+            }
+            return 10;
+        });
+        FCV_ASSERT(v.size() == 10 && v[9] == 9 && v.capacity() >= 20);
+        v.assign(2, v[9]);
+        FCV_ASSERT(v == vector<int, 2>({9, 9}));
+        v.assign({1, 2, 3});
+        FCV_ASSERT(v == vector<int, 2>({1, 2, 3}));
+        v = {4};
+        FCV_ASSERT(v == vector<int, 2>({4}));
+
+        vector<std::string, 2> s(3, default_init);
+        FCV_ASSERT(s.size() == 3 && s[2].empty());
+        vector<std::string, 2> t(3, "x");
+        FCV_ASSERT(t == vector<std::string, 2>({"x", "x", "x"}));
+    }
+
+    {  // input and forward iterators
+        std::istringstream is("1 2 3 4");
+        vector<int, 2> v(std::istream_iterator<int>{is},
+                         std::istream_iterator<int>{});
+        FCV_ASSERT(v == vector<int, 2>({1, 2, 3, 4}));
+        std::istringstream is2("7 8 9");
+        v.insert(v.begin() + 1, std::istream_iterator<int>{is2},
+                 std::istream_iterator<int>{});
+        FCV_ASSERT(v == vector<int, 2>({1, 7, 8, 9, 2, 3, 4}));
+        std::list<int> l = {5, 6};
+        v.append_range(l);
+        v.insert(v.begin(), l.begin(), l.end());
+        FCV_ASSERT(v == vector<int, 2>({5, 6, 1, 7, 8, 9, 2, 3, 4, 5, 6}));
+    }
+
+    {  // try_ modifiers do not allocate, unordered_erase
+        vector<int, 4> v = {1, 2};
+        FCV_ASSERT(v.try_push_back(3) == v.data() + 2);
+        FCV_ASSERT(*v.try_emplace_back(4) == 4 && v.size() == 4);
+        FCV_ASSERT(v.try_push_back(5) == nullptr && v.size() == 4);
+        FCV_ASSERT(v.is_inline());
+
+        v.reserve(6);
+        const int r[] = {5, 6, 7};
+        FCV_ASSERT(v.try_append(r) == r + 2 && v.capacity() == 6);
+        FCV_ASSERT(v == vector<int, 4>({1, 2, 3, 4, 5, 6}));
+        std::istringstream ss("8 9");
+        std::istream_iterator<int> it(ss);
+        v.pop_back();
+        it = v.try_append(it, std::istream_iterator<int>{});
+        FCV_ASSERT(v.size() == 6 && v.back() == 8 && *it == 9);
+
+        FCV_ASSERT(*v.unordered_erase(v.begin() + 1) == 8);
+        FCV_ASSERT(v == vector<int, 4>({1, 8, 3, 4, 5}));
+        FCV_ASSERT(v.unordered_erase(v.end() - 1) == v.end());
+
+        vector<std::string, 2> s = {"a", "b", "c"};
+        FCV_ASSERT(*s.unordered_erase(s.begin()) == "c" && s.size() == 2);
+        s.shrink_to_fit();
+        FCV_ASSERT(s.try_emplace_back("d") == nullptr);
+        const std::list<std::string> l = {"e"};
+        FCV_ASSERT(s.try_append(l) == l.begin());
+        FCV_ASSERT(s == vector<std::string, 2>({"c", "b"}));
+    }
+
+    {  // strong guarantee when the capacity suffices and when it grows
+        for (std::size_t n : {std::size_t{8}, std::size_t{3}})
+        {
+            vector<throwing, 3> v;
+            v.reserve(n);
+            v.emplace_back(1);
+            v.emplace_back(2);
+            v.emplace_back(3);
+            const throwing r[] = {throwing(4), throwing(-1)};
+            bool thrown        = false;
+            try
+            {
+                v.insert(v.begin() + 1, std::begin(r), std::end(r));
+            }
+            catch (int)
+            {
+                thrown = true;
+            }
+            FCV_ASSERT(thrown);
+            FCV_ASSERT(v.size() == 3);
+            FCV_ASSERT(v[0].value == 1 && v[1].value == 2
+                       && v[2].value == 3);
+        }
+    }
+
+    {  // growth: nothing is destroyed until every element was copied
+        static_assert(!std::is_nothrow_move_constructible_v<copy_only>);
+        // the new element, the 2 elements after it, and the 2 before it are
+        // copied to the new buffer: the copy after the first `copies` throws
+        for (int copies = 0; copies != 5; ++copies)
+        {
+            {
+                vector<copy_only, 4> v = {0, 1, 2, 3};
+                const copy_only x(9);
+                copy_only::copies_left = copies;
+                bool thrown            = false;
+                try
+                {
+                    v.insert(v.begin() + 2, x);
+                }
+                catch (int)
+                {
+                    thrown = true;
+                }
+                copy_only::copies_left = -1;
+                FCV_ASSERT(thrown && v.is_inline() && v.size() == 4);
+                FCV_ASSERT(copy_only::live.size() == 5);
+                for (std::size_t i = 0; i != v.size(); ++i)
+                {
+                    FCV_ASSERT(v[i].value == static_cast<int>(i));
+                }
+                v.insert(v.begin() + 2, x);
+                FCV_ASSERT(!v.is_inline() && v.size() == 5 && v[2].value == 9);
+                FCV_ASSERT(copy_only::live.size() == 6);
+            }
+            FCV_ASSERT(copy_only::live.empty());
+        }
+    }
+
+    {  // shift: basic guarantee if copying an element throws
+        // the 4 elements are shifted from the back: the copy after the first
+        // `copies` throws
+        for (int copies = 0; copies != 4; ++copies)
+        {
+            {
+                vector<copy_only, 2> v = {0, 1, 2, 3};
+                v.reserve(8);
+                copy_only::copies_left = copies;
+                bool thrown            = false;
+                try
+                {
+                    v.emplace(v.begin(), 9);
+                }
+                catch (int)
+                {
+                    thrown = true;
+                }
+                copy_only::copies_left = -1;
+                FCV_ASSERT(thrown && copy_only::live.size() == v.size());
+                FCV_ASSERT(v.size() == static_cast<std::size_t>(4 - copies));
+                for (std::size_t i = 0; i != v.size(); ++i)
+                {
+                    FCV_ASSERT(v[i].value == static_cast<int>(i));
+                }
+            }
+            FCV_ASSERT(copy_only::live.empty());
+        }
+    }
+
+    return 0;
+}
@@ -13,9 +13,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <experimental/fixed_capacity_vector>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <set>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 //#include "utils.hpp"
 
@@ -54,6 +62,12 @@ template struct std::experimental::fixed_capacity_vector<std::unique_ptr<int>,
 template struct std::experimental::fixed_capacity_vector<
     const std::unique_ptr<int>, 3>;
 
+// over-aligned:
+template struct std::experimental::fixed_capacity_vector<
+    float, 5, std::experimental::fcv_storage::aligned<32>>;
+template struct std::experimental::fixed_capacity_vector<
+    std::string, 3, std::experimental::fcv_storage::aligned<64>>;
+
 struct [[gsl::suppress("cppcoreguidelines-special-member-functions")]] tint
 {
     std::size_t i;
@@ -194,6 +208,76 @@ struct vec
     }
 };
 
+/// Non-trivial type that opts into trivial relocation, and counts the calls
+/// of its move constructor.
+struct relocatable
+{
+    static int moves;
+    std::unique_ptr<int> p;
+
+    explicit relocatable(int i) : p(std::make_unique<int>(i))
+    {
+    }
+    relocatable(relocatable&& o) noexcept : p(std::move(o.p))
+    {
+        ++moves;
+    }
+    relocatable& operator=(relocatable&& o) noexcept
+    {
+        p = std::move(o.p);
+        ++moves;
+        return *this;
+    }
+};
+
+int relocatable::moves = 0;
+
+/// Counts constructions and assignments.
+struct counted
+{
+    static int constructions;
+    static int assignments;
+    int value;
+
+    counted(int v) : value(v)
+    {
+        ++constructions;
+    }
+    counted(counted const& o) : value(o.value)
+    {
+        ++constructions;
+    }
+    counted(counted&& o) noexcept : value(o.value)
+    {
+        ++constructions;
+    }
+    counted& operator=(counted const& o)
+    {
+        value = o.value;
+        ++assignments;
+        return *this;
+    }
+    counted& operator=(counted&& o) noexcept
+    {
+        value = o.value;
+        ++assignments;
+        return *this;
+    }
+    static void reset()
+    {
+        constructions = assignments = 0;
+    }
+};
+
+int counted::constructions = 0;
+int counted::assignments   = 0;
+
+template <>
+struct std::experimental::is_trivially_relocatable<relocatable>
+    : std::true_type
+{
+};
+
 int main()
 {
     {  // storage
@@ -470,8 +554,9 @@ int main()
         FCV_ASSERT(b.size() == std::size_t{0});
         b = std::move(a);
         FCV_ASSERT(b.size() == std::size_t{3});
+        // unique_ptr is trivially relocatable, so a is left empty:
         [[gsl::suppress("misc-use-after-move")]] {
-            FCV_ASSERT(a.size() == std::size_t{3});
+            FCV_ASSERT(a.size() == std::size_t{0});
         }
     }
 
@@ -481,8 +566,9 @@ int main()
         FCV_ASSERT(a.size() == std::size_t{3});
         vector<MoveOnly, 3> b(std::move(a));
         FCV_ASSERT(b.size() == std::size_t{3});
+        // unique_ptr is trivially relocatable, so a is left empty:
         [[gsl::suppress("misc-use-after-move")]] {
-            FCV_ASSERT(a.size() == std::size_t{3});
+            FCV_ASSERT(a.size() == std::size_t{0});
         }
     }
 
@@ -1059,5 +1145,799 @@ for (++j; j < 101; ++j)
     }
 }
 
+{  // copy and move non-trivial elements
+    using vec_t = vector<std::string, 3>;
+    vec_t a;
+    a.push_back(std::string(100, 'a'));
+    a.push_back(std::string(100, 'b'));
+    vec_t b(a);
+    FCV_ASSERT(b.size() == 2);
+    FCV_ASSERT(b[0] == a[0] && b[1] == a[1]);
+    FCV_ASSERT(b[0].data() != a[0].data());
+    vec_t c;
+    c.push_back("c");
+    c = a;
+    FCV_ASSERT(c == a);
+    vec_t const& c_ref = c;
+    c                  = c_ref;
+    FCV_ASSERT(c == a);
+    vec_t d(std::move(c));
+    FCV_ASSERT(d == a);
+    c = std::move(d);
+    FCV_ASSERT(c == a);
+
+    static_assert(!std::is_copy_constructible<vector<moint, 3>>{});
+    static_assert(std::is_move_constructible<vector<moint, 3>>{});
+}
+
+{  // insert/erase of trivial elements (bulk paths)
+    vector<int, 10> v = {1, 2, 3, 4, 5};
+    v.insert(v.begin() + 1, 2, v.back());  // value aliases an element
+    FCV_ASSERT(v == vector<int, 10>({1, 5, 5, 2, 3, 4, 5}));
+    std::vector<int> src = {7, 8};
+    v.insert(v.begin(), src.data(), src.data() + 2);
+    FCV_ASSERT(v == vector<int, 10>({7, 8, 1, 5, 5, 2, 3, 4, 5}));
+    const long l[] = {9};
+    v.insert(v.end(), l, l + 1);
+    FCV_ASSERT(v.full() && v.back() == 9);
+    v.erase(v.begin() + 2, v.begin() + 5);
+    FCV_ASSERT(v == vector<int, 10>({7, 8, 2, 3, 4, 5, 9}));
+    v.erase(v.begin());
+    FCV_ASSERT(v == vector<int, 10>({8, 2, 3, 4, 5, 9}));
+    v.emplace(v.begin() + 1, 6);
+    FCV_ASSERT(v == vector<int, 10>({8, 6, 2, 3, 4, 5, 9}));
+}
+
+{  // erase in constant expressions (element-wise path)
+    constexpr auto v = [] {
+        vector<int, 5> w = {1, 2, 3, 4, 5};
+        w.erase(w.begin() + 1, w.begin() + 3);
+        return w;
+    }();
+    static_assert(v.size() == 3 && v[0] == 1 && v[1] == 4 && v[2] == 5);
+}
+
+{  // insert into the middle of non-trivial elements
+    using vec_t = vector<std::string, 10>;
+    vec_t v     = {"a", "b", "c"};
+    v.insert(v.begin() + 1, 2, v.back());  // value aliases an element
+    FCV_ASSERT(v == vec_t({"a", "c", "c", "b", "c"}));
+    const std::string r[] = {"x", "y"};
+    v.insert(v.begin() + 2, std::begin(r), std::end(r));
+    FCV_ASSERT(v == vec_t({"a", "c", "x", "y", "c", "b", "c"}));
+    v.emplace(v.begin(), 3, 'z');
+    FCV_ASSERT(v == vec_t({"zzz", "a", "c", "x", "y", "c", "b", "c"}));
+    v.emplace(v.begin(), v.back());  // argument aliases an element
+    FCV_ASSERT(v.front() == "c" && v.size() == 9);
+    std::string m = "m";
+    v.insert(v.end() - 1, std::move(m));
+    FCV_ASSERT(v[8] == "m" && v[9] == "c" && v.full());
+}
+
+{  // insert from forward and input iterators
+    std::list<int> l = {4, 5, 6};
+    vector<int, 10> v = {1, 2, 3};
+    v.insert(v.begin() + 1, l.begin(), l.end());
+    FCV_ASSERT(v == vector<int, 10>({1, 4, 5, 6, 2, 3}));
+
+    std::istringstream is("7 8 9");
+    v.insert(v.begin() + 2, std::istream_iterator<int>(is),
+             std::istream_iterator<int>());
+    FCV_ASSERT(v == vector<int, 10>({1, 4, 7, 8, 9, 5, 6, 2, 3}));
+
+    vector<std::string, 5> s = {"a", "d"};
+    std::istringstream ss("b c");
+    s.insert(s.begin() + 1, std::istream_iterator<std::string>(ss),
+             std::istream_iterator<std::string>());
+    FCV_ASSERT(s == vector<std::string, 5>({"a", "b", "c", "d"}));
+}
+
+{  // insert: strong guarantee if the move constructor does not throw
+    struct throwing
+    {
+        int value;
+        throwing(int v) : value(v)
+        {
+        }
+        throwing(throwing const& o) : value(o.value)
+        {
+            if (value < 0)
+            {
+                throw 42;
+            }
+        }
+        throwing(throwing&&) noexcept = default;
+        throwing& operator=(throwing const&) = default;
+        throwing& operator=(throwing&&) noexcept = default;
+        ~throwing()
+        {
+        }
+    };
+    vector<throwing, 10> v;
+    v.emplace_back(1);
+    v.emplace_back(2);
+    v.emplace_back(3);
+    const throwing r[] = {throwing(4), throwing(-1)};
+    bool thrown        = false;
+    try
+    {
+        v.insert(v.begin() + 1, std::begin(r), std::end(r));
+    }
+    catch (int)
+    {
+        thrown = true;
+    }
+    FCV_ASSERT(thrown);
+    FCV_ASSERT(v.size() == 3);
+    FCV_ASSERT(v[0].value == 1 && v[1].value == 2 && v[2].value == 3);
+}
+
+{  // insert: basic guarantee if shifting the elements throws
+    // copy-only elements that record the live objects:
+    struct copy_only
+    {
+        int value;
+        std::set<copy_only const*>* live;
+        int* copies_left;
+
+        copy_only(int v, std::set<copy_only const*>* l, int* c)
+            : value(v), live(l), copies_left(c)
+        {
+            live->insert(this);
+        }
+        copy_only(copy_only const& o)
+            : value(o.value), live(o.live), copies_left(o.copies_left)
+        {
+            if (*copies_left == 0)
+            {
+                throw 42;
+            }
+            --*copies_left;
+            live->insert(this);
+        }
+        copy_only& operator=(copy_only const&) = default;
+        ~copy_only()
+        {
+            FCV_ASSERT(live->erase(this) == 1);
+        }
+    };
+    static_assert(!std::is_nothrow_move_constructible<copy_only>{});
+
+    std::set<copy_only const*> live;
+    int copies_left = -1;
+    // the 4 elements are shifted from the back, and then the new element is
+    // copied into the gap: the copy after the first `copies` ones throws
+    for (int copies = 1; copies != 5; ++copies)
+    {
+        {
+            vector<copy_only, 8> v;
+            for (int i = 0; i != 4; ++i)
+            {
+                v.emplace_back(i, &live, &copies_left);
+            }
+            copies_left = copies;
+            bool thrown = false;
+            try
+            {
+                v.emplace(v.begin(), 9, &live, &copies_left);
+            }
+            catch (int)
+            {
+                thrown = true;
+            }
+            copies_left = -1;
+            FCV_ASSERT(thrown && live.size() == v.size());
+            FCV_ASSERT(v.size() == static_cast<std::size_t>(4 - copies));
+            for (std::size_t i = 0; i != v.size(); ++i)
+            {
+                FCV_ASSERT(v[i].value == static_cast<int>(i));
+            }
+        }
+        FCV_ASSERT(live.empty());
+    }
+}
+
+{  // uninitialized storage policy
+    using std::experimental::fcv_storage::uninitialized;
+    using uvec = std::experimental::fixed_capacity_vector<int, 1024,
+                                                          uninitialized>;
+    static_assert(
+        std::is_same<std::experimental::fcv_detail::storage::
+                         sized_copy_trivial<int, 1024>,
+                     std::experimental::fcv_storage::uninitialized::type<
+                         int, 1024>>{});
+    static_assert(std::is_same<
+                  std::experimental::fixed_capacity_vector<std::string, 3,
+                                                           uninitialized>::
+                      value_type,
+                  std::string>{});
+
+    uvec v;
+    FCV_ASSERT(v.empty());
+    FCV_ASSERT(v.capacity() == 1024);
+    v = {1, 2, 3};
+    v.insert(v.begin() + 1, 5, 7);
+    v.erase(v.begin(), v.begin() + 2);
+    FCV_ASSERT(v.size() == 6);
+    FCV_ASSERT(v[0] == 7 && v[4] == 2 && v[5] == 3);
+
+    uvec w(v);
+    FCV_ASSERT(w == v);
+    w.resize(10);
+    FCV_ASSERT(w.size() == 10 && w[9] == 0);
+    FCV_ASSERT(v != w);
+
+    std::experimental::fixed_capacity_vector<std::string, 3, uninitialized>
+        s = {"a", "b"};
+    s.push_back("c");
+    FCV_ASSERT(s.full() && s[2] == "c");
+}
+
+{  // uninitialized storage: passing iterators into unused capacity
+    std::experimental::fixed_capacity_vector<
+        int, 8, std::experimental::fcv_storage::uninitialized>
+        v;
+    v.emplace(v.cbegin(), 3);
+    v.insert(v.cend(), 2, 4);
+    FCV_ASSERT(v.size() == 3 && v[0] == 3 && v[2] == 4);
+}
+
+{  // uninitialized storage: copies are proportional to the size
+    using std::experimental::fcv_storage::uninitialized;
+    using std::experimental::fcv_storage::uninitialized_trivially_copyable;
+    using svec = std::experimental::fixed_capacity_vector<unsigned, 4096,
+                                                          uninitialized>;
+    using tvec = std::experimental::fixed_capacity_vector<
+        unsigned, 4096, uninitialized_trivially_copyable>;
+    static_assert(!std::is_trivially_copyable<svec>{});
+    static_assert(std::is_nothrow_copy_constructible<svec>{});
+    static_assert(std::is_nothrow_move_assignable<svec>{});
+    static_assert(std::is_trivially_copyable<tvec>{});
+
+    auto check = [](auto a) {
+        using V = decltype(a);
+        V b(a);
+        FCV_ASSERT(b == a);
+        V c(std::move(b));
+        FCV_ASSERT(c == a);
+        V d = {9};
+        d   = c;
+        FCV_ASSERT(d == a);
+        V const& dr = d;
+        d           = dr;
+        FCV_ASSERT(d == a);
+        V e = {1, 2, 3, 4, 5};
+        e   = std::move(d);
+        FCV_ASSERT(e == a);
+        V f;
+        e = f;
+        FCV_ASSERT(e.empty());
+        e.swap(c);
+        FCV_ASSERT(e == a && c.empty());
+    };
+    check(svec{1, 2, 3});
+    check(tvec{1, 2, 3});
+}
+
+{  // try_push_back, try_emplace_back, unchecked_emplace_back
+    vector<int, 2> v;
+    int* p = v.try_push_back(1);
+    FCV_ASSERT(p == v.data() && *p == 1);
+    FCV_ASSERT(v.try_emplace_back(2) == v.data() + 1);
+    FCV_ASSERT(v.try_push_back(3) == nullptr);
+    FCV_ASSERT(v.try_emplace_back(3) == nullptr);
+    FCV_ASSERT(v == vector<int, 2>({1, 2}));
+
+    vector<std::string, 3> s;
+    s.unchecked_emplace_back(2, 'a') += "b";
+    FCV_ASSERT(s.try_emplace_back("c")->size() == 1);
+    FCV_ASSERT(s.try_push_back(std::string("d")) != nullptr);
+    FCV_ASSERT(s.try_push_back(std::string("e")) == nullptr);
+    FCV_ASSERT(s == vector<std::string, 3>({"aab", "c", "d"}));
+
+    constexpr auto c = [] {
+        vector<int, 3> x;
+        x.unchecked_emplace_back(1);
+        x.try_push_back(2);
+        x.try_push_back(3);
+        return x.try_push_back(4) == nullptr ? x.back() : 0;
+    }();
+    static_assert(c == 3);
+}
+
+{  // append_range, try_append
+    vector<int, 6> v = {1};
+    int a[]          = {2, 3};
+    v.append_range(a);
+    v.append_range(std::list<int>{4});
+    FCV_ASSERT(v == vector<int, 6>({1, 2, 3, 4}));
+
+    std::list<int> l = {5, 6, 7, 8};
+    auto it          = v.try_append(l);
+    FCV_ASSERT(it != l.end() && *it == 7);
+    FCV_ASSERT(v == vector<int, 6>({1, 2, 3, 4, 5, 6}));
+    FCV_ASSERT(v.try_append(a) == std::begin(a));
+
+    vector<std::string, 3> s = {"a"};
+    std::string ss[]         = {"b", "c", "d"};
+    FCV_ASSERT(s.try_append(std::begin(ss), std::end(ss)) == ss + 2);
+    FCV_ASSERT(s == vector<std::string, 3>({"a", "b", "c"}));
+
+    std::istringstream is("1 2 3 4");
+    vector<int, 3> w;
+    std::istream_iterator<int> first(is), last;
+    first = w.try_append(first, last);
+    FCV_ASSERT(w == vector<int, 3>({1, 2, 3}));
+    FCV_ASSERT(first != last && *first == 4);
+    w.clear();
+    w.append_range(first, last);
+    FCV_ASSERT(w == vector<int, 3>({4}));
+
+    constexpr auto c = [] {
+        vector<int, 4> x = {1};
+        int y[]          = {2, 3, 4, 5};
+        return x.try_append(y) - y;
+    }();
+    static_assert(c == 3);
+}
+
+{  // default-initialized resize and construction
+    using std::experimental::default_init;
+    vector<int, 10> v = {1, 2, 3};
+    v.resize(6, default_init);
+    FCV_ASSERT(v.size() == 6 && v[0] == 1 && v[2] == 3);
+    v.resize(2, default_init);
+    FCV_ASSERT(v == vector<int, 10>({1, 2}));
+
+    vector<int, 10> w(4, default_init);
+    FCV_ASSERT(w.size() == 4);
+
+    vector<std::string, 4> s(2, default_init);
+    FCV_ASSERT(s.size() == 2 && s[0].empty() && s[1].empty());
+    s[0] = "a";
+    s.resize(3, default_init);
+    s.resize(1, default_init);
+    FCV_ASSERT(s == vector<std::string, 4>({"a"}));
+
+    static_assert(
+        !std::is_convertible<decltype(default_init), std::size_t>{});
+
+    constexpr auto c = [] {
+        vector<int, 4> x(3, default_init);
+        x[2] = 5;
+        return x.size() + x[2];
+    }();
+    static_assert(c == 8);
+}
+
+{  // resize_and_overwrite
+    vector<char, 16> v = {'a', 'b'};
+    v.resize_and_overwrite(v.capacity(), [](char* p, std::size_t n) {
+        FCV_ASSERT(n == 16);
+        FCV_ASSERT(p[0] == 'a' && p[1] == 'b');
+        std::memcpy(p + 2, "cdef", 4);
+        return 6;
+    });
+    FCV_ASSERT(v.size() == 6);
+    FCV_ASSERT(std::string(v.begin(), v.end()) == "abcdef");
+
+    v.resize_and_overwrite(3, [](char*, std::size_t n) { return n; });
+    FCV_ASSERT(std::string(v.begin(), v.end()) == "abc");
+
+    bool thrown = false;
+    try
+    {
+        v.resize_and_overwrite(10, [](char* p, std::size_t) -> std::size_t {
+            p[5] = 'x';
+            throw 42;
+        });
+    }
+    catch (int)
+    {
+        thrown = true;
+    }
+    FCV_ASSERT(thrown && v.size() == 3);
+
+    constexpr auto c = [] {
+        vector<int, 8> x = {1};
+        x.resize_and_overwrite(8, [](int* p, std::size_t) {
+            p[1] = 2;
+            p[2] = 3;
+            return 3;
+        });
+        return x.size() * 10 + x[2];
+    }();
+    static_assert(c == 33);
+}
+
+{  // fixed_capacity_vector_ref over caller-provided memory
+    using std::experimental::fixed_capacity_vector_ref;
+    int buffer[8]    = {};
+    std::size_t size = 0;
+    fixed_capacity_vector_ref<int> v(buffer, 8, size);
+    FCV_ASSERT(v.empty() && v.capacity() == 8 && v.max_size() == 8);
+    v.push_back(3);
+    v.insert(v.begin(), {1, 2});
+    v.resize(5, 7);
+    FCV_ASSERT(size == 5);
+    FCV_ASSERT(buffer[0] == 1 && buffer[2] == 3 && buffer[4] == 7);
+    v.erase(v.begin());
+    FCV_ASSERT(size == 4 && buffer[0] == 2);
+
+    // copies view the same memory
+    fixed_capacity_vector_ref<int> w = v;
+    w.push_back(9);
+    FCV_ASSERT(v.size() == 5 && v.back() == 9 && v == w);
+    v.resize(8);
+    FCV_ASSERT(v.full() && w.full());
+
+    // adopt elements already in the buffer
+    std::size_t three = 3;
+    fixed_capacity_vector_ref<int> u(buffer + 2, 4, three);
+    FCV_ASSERT(u.size() == 3 && u[0] == 7 && u[2] == 9);
+    u.clear();
+    FCV_ASSERT(three == 0 && size == 8);
+
+    // non-trivial elements in raw memory
+    alignas(std::string) unsigned char raw[4 * sizeof(std::string)];
+    std::size_t n = 0;
+    {
+        fixed_capacity_vector_ref<std::string> s(
+            reinterpret_cast<std::string*>(raw), 4, n);
+        s.emplace_back("a string too long for the small buffer");
+        s.insert(s.begin(), "b");
+        FCV_ASSERT(s[0] == "b" && n == 2);
+    }
+    {  // the elements outlive the view
+        fixed_capacity_vector_ref<std::string> s(
+            reinterpret_cast<std::string*>(raw), 4, n);
+        FCV_ASSERT(s.size() == 2 && s[0] == "b");
+        s.clear();
+    }
+    FCV_ASSERT(n == 0);
+
+    // swaps exchange the views, for any element type and capacities
+    {
+        int small[2] = {1, 2}, large[6] = {3, 4, 5, 6, 7, 8};
+        std::size_t small_size = 2, large_size = 6;
+        fixed_capacity_vector_ref<int> a(small, 2, small_size);
+        fixed_capacity_vector_ref<int> b(large, 6, large_size);
+        a.swap(b);
+        FCV_ASSERT(a.data() == large && a.capacity() == 6 && a.size() == 6);
+        FCV_ASSERT(b.data() == small && b.capacity() == 2 && b.size() == 2);
+        FCV_ASSERT(small[0] == 1 && small[1] == 2 && large[5] == 8);
+        FCV_ASSERT(small_size == 2 && large_size == 6);
+    }
+    {
+        alignas(std::string) unsigned char small[sizeof(std::string)];
+        alignas(std::string) unsigned char large[3 * sizeof(std::string)];
+        std::size_t small_size = 0, large_size = 0;
+        fixed_capacity_vector_ref<std::string> a(
+            reinterpret_cast<std::string*>(small), 1, small_size);
+        fixed_capacity_vector_ref<std::string> b(
+            reinterpret_cast<std::string*>(large), 3, large_size);
+        a.emplace_back("x");
+        b.assign({"a", "b", "c"});
+        swap(a, b);
+        FCV_ASSERT(a.capacity() == 3 && a.size() == 3 && a[2] == "c");
+        FCV_ASSERT(b.capacity() == 1 && b.size() == 1 && b[0] == "x");
+        FCV_ASSERT(a.data() == reinterpret_cast<std::string*>(large));
+        a.clear();
+        b.clear();
+    }
+
+    static_assert(vector<int, 4>::capacity() == 4);
+    static_assert(std::is_same<decltype(v.capacity()), std::size_t>{});
+}
+
+{  // lexicographical comparison
+    using vi = vector<int, 200>;
+    FCV_ASSERT((vi{1, 2} < vi{1, 2, 3}) && !(vi{1, 2, 3} < vi{1, 2}));
+    FCV_ASSERT((vi{1, 3} > vi{1, 2, 3}) && (vi{} < vi{0}));
+    FCV_ASSERT((vi{-1} < vi{0}) && (vi{1, 2} <= vi{1, 2}));
+    FCV_ASSERT((vi{1, 2}.compare(vi{1, 2}) == 0));
+    FCV_ASSERT((vi{2}.compare(vi{1, 5}) == 1));
+
+    using vu8 = vector<std::uint8_t, 200>;
+    FCV_ASSERT((vu8{1, 200} < vu8{2}) && (vu8{200} > vu8{1, 255}));
+    FCV_ASSERT((vu8{1, 2} < vu8{1, 2, 0}) && (vu8{} == vu8{}));
+
+    using vs = vector<std::string, 4>;
+    FCV_ASSERT((vs{"a", "b"} < vs{"a", "c"}) && (vs{"b"} > vs{"a", "z"}));
+
+    // mismatches in and after the first 64 byte block
+    vi a(150, 7);
+    vi b = a;
+    FCV_ASSERT(a == b && a.compare(b) == 0);
+    for (std::size_t i : {0, 15, 16, 100, 149})
+    {
+        b[i] = 8;
+        FCV_ASSERT(a != b && a < b && b > a && a.compare(b) == -1);
+        b[i] = 6;
+        FCV_ASSERT(a != b && a > b && b.compare(a) == -1);
+        b[i] = 7;
+    }
+    b.push_back(0);
+    FCV_ASSERT(a < b && a.compare(b) == -1);
+
+    vu8 c(150, 7);
+    vu8 d = c;
+    d[130] = 6;
+    FCV_ASSERT(d < c && c.compare(d) == 1);
+
+    constexpr bool ce = [] {
+        vector<int, 4> x{1, 2}, y{1, 2, 3};
+        return x < y && x != y && !(x == y) && x.compare(x) == 0;
+    }();
+    static_assert(ce);
+
+    // noexcept only if comparing the elements is:
+    struct throwing_less
+    {
+        int x;
+        bool operator<(throwing_less const& o) const
+        {
+            return x < o.x;
+        }
+        bool operator==(throwing_less const& o) const
+        {
+            return x == o.x;
+        }
+    };
+    using vt = vector<throwing_less, 4>;
+    static_assert(noexcept(a.compare(b)) && noexcept(a < b));
+    static_assert(noexcept(a == b) && noexcept(a != b));
+    static_assert(!noexcept(std::declval<vt const&>().compare(vt{})));
+    static_assert(!noexcept(vt{} < vt{}) && !noexcept(vt{} >= vt{}));
+    static_assert(!noexcept(vt{} == vt{}) && !noexcept(vt{} != vt{}));
+    FCV_ASSERT((vt{{1}, {2}} == vt{{1}, {2}}) && (vt{{1}} != vt{{2}}));
+    FCV_ASSERT((vt{{1}, {2}} < vt{{1}, {3}}) && (vt{{2}}.compare(vt{}) == 1));
+}
+
+{  // aligned storage policy: over-aligned data() and padded capacity
+    using std::experimental::fcv_storage::aligned;
+    using std::experimental::fcv_storage::uninitialized;
+    using fvec = std::experimental::fixed_capacity_vector<float, 10,
+                                                          aligned<32>>;
+    static_assert(fvec::capacity() == 16);
+    static_assert(alignof(fvec) == 32 && sizeof(fvec) % 32 == 0);
+    static_assert(
+        std::experimental::fixed_capacity_vector<double, 10,
+                                                 aligned<64>>::capacity()
+        == 16);
+    struct rgb
+    {
+        char c[3];
+    };
+    static_assert(
+        std::experimental::fixed_capacity_vector<rgb, 5,
+                                                 aligned<8>>::capacity()
+        == 8);
+    static_assert(
+        std::experimental::fixed_capacity_vector<int, 0,
+                                                 aligned<64>>::capacity()
+        == 0);
+    static_assert(aligned<32>::alignment == 32);
+
+    auto is_aligned = [](void const* p, std::size_t a) {
+        return reinterpret_cast<std::uintptr_t>(p) % a == 0;
+    };
+    fvec v = {1.f, 2.f, 3.f};
+    FCV_ASSERT(is_aligned(v.data(), 32));
+    auto h = std::make_unique<fvec>(v);
+    FCV_ASSERT(is_aligned(h->data(), 32) && *h == v);
+
+    // A whole final block past size() is alive and zero-initialized:
+    float* d = v.data();
+    for (std::size_t i = 0; i != 8; ++i)
+    {
+        d[i] *= 2.f;
+    }
+    FCV_ASSERT(v.size() == 3 && v[2] == 6.f && d[7] == 0.f);
+
+    std::experimental::fixed_capacity_vector<std::uint8_t, 1,
+                                             aligned<64, uninitialized>>
+        u(64, std::uint8_t{7});
+    FCV_ASSERT(u.full() && u.capacity() == 64 && is_aligned(u.data(), 64));
+
+    std::experimental::fixed_capacity_vector<std::string, 3, aligned<64>> s
+        = {"a", "b"};
+    FCV_ASSERT(is_aligned(s.data(), 64) && s[1] == "b");
+    s.push_back("c");
+    auto t = s;
+    FCV_ASSERT(t == s && is_aligned(t.data(), 64));
+
+    constexpr auto c = [] {
+        std::experimental::fixed_capacity_vector<int, 3, aligned<16>> c
+            = {1, 2};
+        c.push_back(3);
+        c.push_back(4);
+        return c;
+    }();
+    static_assert(c.full() && c.back() == 4);
+}
+
+{  // trivially relocatable elements
+    using std::experimental::is_trivially_relocatable_v;
+    using ptr = std::unique_ptr<int>;
+    static_assert(is_trivially_relocatable_v<int>);
+    static_assert(is_trivially_relocatable_v<ptr>);
+    static_assert(is_trivially_relocatable_v<std::shared_ptr<int>>);
+    static_assert(is_trivially_relocatable_v<std::pair<ptr, int>>);
+    static_assert(!is_trivially_relocatable_v<std::pair<ptr, std::string>>);
+    static_assert(!is_trivially_relocatable_v<std::string>);
+    static_assert(is_trivially_relocatable_v<relocatable>);
+    static_assert(is_trivially_relocatable_v<vector<ptr, 4>>);
+    static_assert(!is_trivially_relocatable_v<vector<std::string, 4>>);
+
+    // shifting, erasing, moving and swapping elements does not call their
+    // move constructor (emplace moves the new element into place once):
+    relocatable::moves = 0;
+    vector<relocatable, 8> a;
+    for (int i = 0; i != 4; ++i)
+    {
+        a.emplace(a.begin(), i);
+    }
+    FCV_ASSERT(relocatable::moves == 3);
+    relocatable::moves = 0;
+    FCV_ASSERT(*a[0].p == 3 && *a[3].p == 0);
+    a.erase(a.begin() + 1, a.begin() + 3);
+    FCV_ASSERT(a.size() == 2 && *a[0].p == 3 && *a[1].p == 0);
+    vector<relocatable, 8> b(std::move(a));
+    FCV_ASSERT(b.size() == 2 && *b[1].p == 0);
+    [[gsl::suppress("misc-use-after-move")]] {
+        FCV_ASSERT(a.empty());
+    }
+    a.emplace_back(7);
+    a.emplace_back(8);
+    a.emplace_back(9);
+    a.swap(b);
+    FCV_ASSERT(a.size() == 2 && *a[0].p == 3 && *a[1].p == 0);
+    FCV_ASSERT(b.size() == 3 && *b[2].p == 9);
+    a = std::move(b);
+    FCV_ASSERT(a.size() == 3 && *a[0].p == 7);
+    [[gsl::suppress("misc-use-after-move")]] {
+        FCV_ASSERT(b.empty());
+    }
+    FCV_ASSERT(relocatable::moves == 0);
+
+    vector<ptr, 4> c;
+    c.push_back(std::make_unique<int>(1));
+    vector<ptr, 4> d;
+    d.swap(c);
+    FCV_ASSERT(c.empty() && d.size() == 1 && *d[0] == 1);
+    vector<vector<ptr, 4>, 3> cs;
+    cs.push_back(std::move(d));
+    cs.insert(cs.begin(), vector<ptr, 4>(2));
+    FCV_ASSERT(cs[0].size() == 2 && *cs[1][0] == 1);
+
+    // elements that are not trivially relocatable are still moved:
+    vector<std::string, 4> s = {"a", "b", "c"};
+    s.erase(s.begin());
+    s.insert(s.begin(), "d");
+    vector<std::string, 4> t = {"e"};
+    s.swap(t);
+    FCV_ASSERT(t.size() == 3 && t[0] == "d" && t[2] == "c" && s[0] == "e");
+}
+
+{  // unordered_erase, erase_if and erase
+    vector<int, 8> a = {0, 1, 2, 3, 4};
+    auto it          = a.unordered_erase(a.begin() + 1);
+    FCV_ASSERT(it == a.begin() + 1 && *it == 4 && a.size() == 4);
+    it = a.unordered_erase(a.end() - 1);
+    FCV_ASSERT(it == a.end() && a == (vector<int, 8>{0, 4, 2}));
+
+    vector<std::unique_ptr<int>, 4> ps;
+    for (int i = 0; i != 3; ++i)
+    {
+        ps.push_back(std::make_unique<int>(i));
+    }
+    ps.unordered_erase(ps.begin());
+    FCV_ASSERT(ps.size() == 2 && *ps[0] == 2 && *ps[1] == 1);
+
+    vector<std::string, 6> s = {"a", "b", "a", "c", "a"};
+    FCV_ASSERT(std::experimental::erase(s, std::string("a")) == 3);
+    FCV_ASSERT(s == (vector<std::string, 6>{"b", "c"}));
+    s.unordered_erase(s.begin());
+    FCV_ASSERT(s.size() == 1 && s[0] == "c");
+    FCV_ASSERT(std::experimental::erase_if(
+                   s, [](std::string const& x) { return x.empty(); })
+               == 0);
+
+    // Compaction kernels, at every removal density and for sizes that end
+    // in a partial block:
+    auto check = [](auto zero, std::size_t n, std::size_t every) {
+        using T = decltype(zero);
+        vector<T, 100> v;
+        std::vector<T> expected;
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            v.push_back(static_cast<T>(i));
+            if (i % every != 0)
+            {
+                expected.push_back(static_cast<T>(i));
+            }
+        }
+        std::size_t calls = 0;
+        const auto erased = std::experimental::erase_if(v, [&](T const& x) {
+            FCV_ASSERT(x == static_cast<T>(calls++));
+            return static_cast<std::size_t>(x) % every == 0;
+        });
+        FCV_ASSERT(calls == n && erased == n - expected.size());
+        FCV_ASSERT(std::equal(v.begin(), v.end(), expected.begin(),
+                              expected.end()));
+    };
+    for (std::size_t n : {0, 1, 7, 8, 9, 31, 64, 100})
+    {
+        for (std::size_t every : {1, 2, 3, 5, 101})
+        {
+            check(std::uint8_t{}, n, every);
+            check(int{}, n, every);
+            check(float{}, n, every);
+            check(std::uint64_t{}, n, every);
+            check(double{}, n, every);
+        }
+    }
+
+    vector<int, 8> b = {1, 2, 1, 3};
+    FCV_ASSERT(std::experimental::erase(b, 1) == 2);
+    FCV_ASSERT(b == (vector<int, 8>{2, 3}));
+
+    constexpr auto c = [] {
+        vector<int, 8> c = {1, 2, 3, 4, 5, 6};
+        std::experimental::erase_if(c, [](int x) { return x % 2 == 0; });
+        c.unordered_erase(c.begin());
+        return c;
+    }();
+    static_assert(c.size() == 2 && c[0] == 5 && c[1] == 3);
+}
+
+{  // assignments reuse the existing elements
+    using cv = vector<counted, 8>;
+    cv a     = {1, 2, 3};
+    cv b     = {4, 5, 6, 7, 8};
+    counted::reset();
+    a = b;
+    FCV_ASSERT(counted::assignments == 3 && counted::constructions == 2);
+    FCV_ASSERT(a.size() == 5 && a[4].value == 8);
+    cv c = {9};
+    counted::reset();
+    a = c;
+    FCV_ASSERT(counted::assignments == 1 && counted::constructions == 0);
+    FCV_ASSERT(a.size() == 1 && a[0].value == 9);
+    counted::reset();
+    a = std::move(b);
+    FCV_ASSERT(counted::assignments == 1 && counted::constructions == 4);
+    FCV_ASSERT(a.size() == 5 && b.size() == 5);
+
+    std::list<counted> l = {1, 2};
+    counted::reset();
+    a.assign(l.begin(), l.end());
+    FCV_ASSERT(counted::assignments == 2 && counted::constructions == 0);
+    FCV_ASSERT(a.size() == 2 && a[1].value == 2);
+    std::istringstream in("3 4 5");
+    a.assign(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    FCV_ASSERT(a.size() == 3 && a[0].value == 3 && a[2].value == 5);
+    counted::reset();
+    a.assign(4, a[1]);
+    FCV_ASSERT(counted::assignments == 3 && counted::constructions == 1);
+    FCV_ASSERT(std::all_of(a.begin(), a.end(),
+                           [](counted const& x) { return x.value == 4; }));
+    a.assign({counted(6)});
+    FCV_ASSERT(a.size() == 1 && a[0].value == 6);
+
+    // strings keep their buffers:
+    const std::string long_a(100, 'a'), long_b(50, 'b');
+    vector<std::string, 4> s = {long_a, long_a};
+    vector<std::string, 4> t = {long_b, long_b, long_b};
+    char const* buffer       = s[0].data();
+    s                        = t;
+    FCV_ASSERT(s == t && s[0].data() == buffer);
+    s.assign(2, long_a);
+    FCV_ASSERT(s.size() == 2 && s[1] == long_a && s[0].data() == buffer);
+    s.assign({long_b});
+    FCV_ASSERT(s.size() == 1 && s[0] == long_b && s[0].data() == buffer);
+}
+
 return 0;
 }